@@ -1,6 +1,5 @@
 
 
-
 #include <string.h>
 
 #include "am_fix.h"
@@ -11,6 +10,7 @@
 #include "frequencies.h"
 #include "functions.h"
 #include "misc.h"
+#include "scheduler.h"
 #include "settings.h"
 #ifdef ENABLE_AGC_SHOW_DATA
 #include "ui/main.h"
@@ -24,10 +24,7 @@ typedef struct
     int8_t   gain_dB;
 } __attribute__((packed)) t_gain_table;
 
-
-#define LOOKUP_TABLE 1
-
-#if LOOKUP_TABLE
+// entry 0 is the reference gain, the rest is sorted by ascending gain
 static const t_gain_table gain_table[] =
 {
     {0x03BE, -7},    
@@ -76,100 +73,69 @@ static const t_gain_table gain_table[] =
     {0x03FF,0}       
 };
 
-const uint8_t gain_table_size = ARRAY_SIZE(gain_table);
-#else
-
-t_gain_table gain_table[100] = {{0x03BE, -7}};  
-uint8_t gain_table_size = 0;
 
-void CreateTable()
+typedef struct
 {
-typedef union  {
-    struct {
-        uint8_t pgaIdx:3;
-        uint8_t mixerIdx:2;
-        uint8_t lnaIdx:3;
-        uint8_t lnaSIdx:2;
-    };
-    uint16_t __raw;
-} GainData;
-
-    static const int8_t lna_short_dB[] = {-28, -24, -19,  0};    
-    static const int8_t lna_dB[]       = {-24, -19, -14,  -9, -6, -4, -2, 0};
-    static const int8_t mixer_dB[]     = { -8,  -6,  -3,   0};
-    static const int8_t pga_dB[]       = {-33, -27, -21, -15, -9, -6, -3, 0};
-
-    unsigned i;
-    for (uint8_t lnaSIdx = 0; lnaSIdx < ARRAY_SIZE(lna_short_dB); lnaSIdx++) {
-        for (uint8_t lnaIdx = 0; lnaIdx < ARRAY_SIZE(lna_dB); lnaIdx++) {
-            for (uint8_t mixerIdx = 0; mixerIdx < ARRAY_SIZE(mixer_dB); mixerIdx++) {
-                for (uint8_t pgaIdx = 0; pgaIdx < ARRAY_SIZE(pga_dB); pgaIdx++) {
-                    int16_t db = lna_short_dB[lnaSIdx] + lna_dB[lnaIdx] + mixer_dB[mixerIdx] + pga_dB[pgaIdx];
-                    GainData gainData = {{
-                        pgaIdx,
-                        mixerIdx,
-                        lnaIdx,
-                        lnaSIdx,
-                    }};
-
-                    for (i = 1; i < ARRAY_SIZE(gain_table); i++) {
-                        t_gain_table * gain = &gain_table[i];
-                        if (db == gain->gain_dB)
-                            break;
-                        if (db > gain->gain_dB)
-                            continue;
-                        if (db < gain->gain_dB) {
-                            if(gain->gain_dB)
-                                memmove(gain + 1, gain, 100 - i);
-                            gain->gain_dB = db;
-                            gain->reg_val = gainData.__raw;
-                            break;
-                        }
-                        gain->gain_dB = db;
-                        gain->reg_val = gainData.__raw;
-                        break;
-                    }
-                }
-            }
-        }
-    }
+    uint32_t frequency;
+    int16_t  rssi;
+    uint8_t  index;
+    uint8_t  hold_10ms;
+    uint8_t  decay_10ms;
+    uint8_t  settle_10ms;
+} AM_fix_state_t;
 
-    gain_table_size = i+1;
-}
-#endif
+// kept per VFO so dual watch resumes each channel at its own gain
+static AM_fix_state_t state[2];
 
+AM_fix_trace_t gAM_fixTrace;
 
 #ifdef ENABLE_AM_FIX___SHOW_DATA
-     
-    static const unsigned int display_update_rate = 250 / 10;    
-    unsigned int counter = 0;
+    static const unsigned int display_update_rate = 250 / 10;
+    static unsigned int counter = 0;
 #endif
 
-unsigned int gain_table_index[2] = {0, 0};
- 
-unsigned int gain_table_index_prev[2] = {0, 0};
- 
-int16_t prev_rssi[2] = {0, 0};
- 
-unsigned int hold_counter[2] = {0, 0};
- 
-const int16_t desired_rssi = (-89 + 160) * 2;
-
-int8_t currentGainDiff;
-bool enabled = true;
-
-void AM_fix_init(void)
-{    
-    for (int i = 0; i < 2; i++) {
-        gain_table_index[i] = 0;   
+static const int16_t desired_rssi = (-89 + 160) * 2;
+
+// below the target by less than this, the gain is held rather than raised
+static const int16_t decay_window_dB = 6;
+
+static int8_t currentGainDiff;
+static bool   enabled = true;
+
+// highest step whose gain does not exceed gain_dB, step 1 if none does
+static unsigned int FindGainStep(const int16_t gain_dB)
+{
+    unsigned int lo = 1;
+    unsigned int hi = ARRAY_SIZE(gain_table) - 1;
+
+    while (lo < hi) {
+        const unsigned int mid = (lo + hi + 1) / 2;
+        if (gain_table[mid].gain_dB <= gain_dB)
+            lo = mid;
+        else
+            hi = mid - 1;
     }
-#if !LOOKUP_TABLE
-    CreateTable();
-#endif
+
+    return lo;
+}
+
+static void Trace(const unsigned vfo, const int16_t rssi, const unsigned int index)
+{
+    AM_fix_sample_t *pSample = &gAM_fixTrace.sample[gAM_fixTrace.head];
+
+    pSample->time_10ms = gGlobalSysTickCounter;
+    pSample->rssi      = rssi;
+    pSample->vfo       = vfo;
+    pSample->index     = index;
+    pSample->gain_dB   = gain_table[index].gain_dB;
+
+    gAM_fixTrace.head = (gAM_fixTrace.head + 1) % AM_FIX_TRACE_SIZE;
+    if (gAM_fixTrace.count < AM_FIX_TRACE_SIZE)
+        gAM_fixTrace.count++;
 }
 
 void AM_fix_reset(const unsigned vfo)
-{    
+{
     if (vfo > 1)
         return;
 
@@ -177,138 +143,110 @@ void AM_fix_reset(const unsigned vfo)
         counter = 0;
     #endif
 
-    prev_rssi[vfo] = 0;
-    hold_counter[vfo] = 0;
-    gain_table_index_prev[vfo] = 0;
+    state[vfo].rssi        = 0;
+    state[vfo].index       = FindGainStep(gain_table[0].gain_dB);
+    state[vfo].hold_10ms   = 0;
+    state[vfo].decay_10ms  = 0;
+    state[vfo].settle_10ms = 0;
 }
 
-
 void AM_fix_10ms(const unsigned vfo)
 {
-    if(!gSetting_AM_fix || !enabled || vfo > 1 )
+    if (!gSetting_AM_fix || !enabled || vfo > 1)
         return;
 
     if (gCurrentFunction != FUNCTION_FOREGROUND && !FUNCTION_IsRx()) {
 #ifdef ENABLE_AM_FIX___SHOW_DATA
-        counter = display_update_rate;   
+        counter = display_update_rate;
 #endif
         return;
     }
 
 #ifdef ENABLE_AM_FIX___SHOW_DATA
     if (counter > 0) {
-        if (++counter >= display_update_rate) {  
+        if (++counter >= display_update_rate) {
             counter        = 0;
             gUpdateDisplay = true;
         }
     }
 #endif
 
-    static uint32_t lastFreq[2];
-    if(gEeprom.VfoInfo[vfo].pRX->Frequency != lastFreq[vfo]) {
-        lastFreq[vfo] = gEeprom.VfoInfo[vfo].pRX->Frequency;
+    AM_fix_state_t *pState = &state[vfo];
+
+    if (gEeprom.VfoInfo[vfo].pRX->Frequency != pState->frequency) {
         AM_fix_reset(vfo);
+        pState->frequency = gEeprom.VfoInfo[vfo].pRX->Frequency;
     }
 
-    int16_t rssi;
-    {    
-         
-        const int16_t new_rssi = BK4819_GetRSSI();
-        rssi                   = (prev_rssi[vfo] > 0) ? (prev_rssi[vfo] + new_rssi) / 2 : new_rssi;
-        prev_rssi[vfo]         = new_rssi;
+    // the RSSI of the first ticks after a step still shows the old gain
+    if (pState->settle_10ms > 0) {
+        pState->settle_10ms--;
+        return;
     }
 
-#ifdef ENABLE_AM_FIX___SHOW_DATA
+    int16_t rssi;
     {
-        static int16_t lastRssi;
-
-        if (lastRssi != rssi) {  
-            lastRssi = rssi;
-
-            if (counter == 0) {
-                counter        = 1;
-                gUpdateDisplay = true;  
-            }
-        }
+        const int16_t new_rssi = BK4819_GetRSSI();
+        rssi                   = (pState->rssi > 0) ? (pState->rssi + new_rssi) / 2 : new_rssi;
+        pState->rssi           = new_rssi;
     }
-#endif
-
-
-    if (hold_counter[vfo] > 0)
-        hold_counter[vfo]--;
-
-     
-    int16_t diff_dB = (rssi - desired_rssi) / 2;
-
-    if (diff_dB > 0) {   
-        unsigned int index = gain_table_index[vfo];    
-
-        if (diff_dB >= 10) {     
-             
-
-            const int16_t desired_gain_dB = (int16_t)gain_table[index].gain_dB - diff_dB + 8;  
-
-             
-            while (index > 1)
-                if (gain_table[--index].gain_dB <= desired_gain_dB)
-                    break;
-        }
-        else
-        {    
-            if (index > 1)
-                index--;      
-        }
 
-        index = MAX(1u, index);
+    const int16_t error_dB = (rssi - desired_rssi) / 2;
+    unsigned int  index    = pState->index;
 
-        if (gain_table_index[vfo] != index)
-        {
-            gain_table_index[vfo] = index;
-            hold_counter[vfo] = 30;        
-        }
+    if (error_dB > 0) {
+        // attack, take the whole excess off in one go
+        index = FindGainStep(gain_table[index].gain_dB - error_dB);
     }
 
-    if (diff_dB >= -6)                     
-        hold_counter[vfo] = 30;            
-
-    if (hold_counter[vfo] == 0)
-    {    
-        const unsigned int index = gain_table_index[vfo] + 1;                  
-        gain_table_index[vfo] = MIN(index, gain_table_size - 1u);
+    if (error_dB >= -decay_window_dB) {
+        pState->hold_10ms  = am_fix_hold_10ms;
+        pState->decay_10ms = 0;
+    }
+    else if (pState->hold_10ms > 0) {
+        pState->hold_10ms--;
+    }
+    else if (++pState->decay_10ms >= am_fix_decay_10ms) {
+        // decay, close half of the remaining gap but at least one step
+        pState->decay_10ms = 0;
+        index = MAX(FindGainStep(gain_table[index].gain_dB - error_dB / 2), index + 1);
+        index = MIN(index, ARRAY_SIZE(gain_table) - 1u);
     }
 
+    if (index != pState->index) {
+        pState->rssi        = 0;
+        pState->settle_10ms = am_fix_settle_10ms;
+    }
 
-    {    
-        const unsigned int index = gain_table_index[vfo];
+    pState->index   = index;
+    currentGainDiff = gain_table[0].gain_dB - gain_table[index].gain_dB;
 
-         
-        gain_table_index_prev[vfo] = index;
-        currentGainDiff = gain_table[0].gain_dB - gain_table[index].gain_dB;
+    if (BK4819_GetShadow(BK4819_REG_13) != gain_table[index].reg_val) {
         BK4819_WriteRegister(BK4819_REG_13, gain_table[index].reg_val);
+        Trace(vfo, rssi, index);
 #ifdef ENABLE_AGC_SHOW_DATA
         UI_MAIN_PrintAGC(true);
 #endif
-    }
-
 #ifdef ENABLE_AM_FIX___SHOW_DATA
-    if (counter == 0) {
-        counter        = 1;
-        gUpdateDisplay = true;
-    }
+        if (counter == 0) {
+            counter        = 1;
+            gUpdateDisplay = true;
+        }
 #endif
+    }
 }
 
 #ifdef ENABLE_AM_FIX___SHOW_DATA
 void AM_fix_print_data(const unsigned vfo, char *s) {
-    if (s != NULL && vfo < ARRAY_SIZE(gain_table_index)) {
-        const unsigned int index = gain_table_index[vfo];
-        sprintf(s, "%2u %4ddB %3u", index, gain_table[index].gain_dB, prev_rssi[vfo]);
+    if (s != NULL && vfo < ARRAY_SIZE(state)) {
+        const unsigned int index = state[vfo].index;
+        sprintf(s, "%2u %4ddB %3u", index, gain_table[index].gain_dB, state[vfo].rssi);
         counter = 0;
     }
 }
 #endif
 
-int8_t AM_fix_get_gain_diff()
+int8_t AM_fix_get_gain_diff(void)
 {
     return currentGainDiff;
 }
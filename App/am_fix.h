@@ -1,3 +1,39 @@
+#ifndef AM_FIX_H
+#define AM_FIX_H
 
+#ifdef ENABLE_AM_FIX__
 
+#include <stdbool.h>
+#include <stdint.h>
 
+#define AM_FIX_TRACE_SIZE 16
+
+// one entry per REG_13 change, read out over UART for tuning
+typedef struct {
+    uint16_t time_10ms;
+    uint16_t rssi;
+    uint8_t  vfo;
+    uint8_t  index;
+    int8_t   gain_dB;
+    uint8_t  padding;
+} AM_fix_sample_t;
+
+typedef struct {
+    AM_fix_sample_t sample[AM_FIX_TRACE_SIZE];
+    uint8_t         head;
+    uint8_t         count;
+} AM_fix_trace_t;
+
+extern AM_fix_trace_t gAM_fixTrace;
+
+void   AM_fix_reset(const unsigned vfo);
+void   AM_fix_10ms(const unsigned vfo);
+#ifdef ENABLE_AM_FIX___SHOW_DATA
+void   AM_fix_print_data(const unsigned vfo, char *s);
+#endif
+int8_t AM_fix_get_gain_diff(void);
+void   AM_fix_enable(bool on);
+
+#endif
+
+#endif
@@ -20,11 +20,14 @@
 //  #include "ARMCM0.h"
 //#endif
 
+#include <string.h>
+
 #include "app/aircopy.h"
 #include "audio.h"
 #include "driver/bk4819.h"
 #include "driver/crc.h"
 #include "driver/eeprom.h"
+#include "driver/py25q16.h"
 #include "frequencies.h"
 #include "misc.h"
 #include "radio.h"
@@ -38,6 +41,19 @@
 
 static const uint16_t Obfuscation[8] = { 0x6C16, 0xE614, 0x912E, 0x400D, 0x3521, 0x40D5, 0x0313, 0x80E9 };
 
+// v2 frames keep the v1 layout but set bit 15 of the offset word, which v1
+// receivers reject as out of range. Bits 14-12 give the frame type, the low
+// bits the block number. FILL and NACK carry a block bitmap as payload.
+#define AIRCOPY_BLOCKS      0x78
+#define AIRCOPY_V2          0x8000u
+#define AIRCOPY_V2_TYPE     0x7000u
+#define AIRCOPY_V2_DATA     0x0000u
+#define AIRCOPY_V2_FILL     0x1000u
+#define AIRCOPY_V2_END      0x2000u
+#define AIRCOPY_V2_NACK     0x3000u
+#define AIRCOPY_V2_ARG      0x0FFFu
+#define AIRCOPY_V2_RETRIES  3
+
 AIRCOPY_State_t gAircopyState;
 uint16_t gAirCopyBlockNumber;
 uint16_t gErrorsDuringAirCopy;
@@ -45,58 +61,282 @@ uint8_t gAirCopyIsSendMode;
 
 uint16_t g_FSK_Buffer[36];
 
+// sender: blocks still to go this round, receiver: blocks stored so far
+static uint8_t  gBlockMap[(AIRCOPY_BLOCKS + 7) / 8];
+static uint8_t  gBlankMap[(AIRCOPY_BLOCKS + 7) / 8];
+static uint8_t  gNextBlock;
+static uint8_t  gSendCountdown_10ms = 1;
+static uint8_t  gEndRetries;
+static bool     gAwaitingReport;
+static uint16_t gReportCountdown_10ms;
+
+static bool TestBlock(const uint8_t *pMap, const unsigned int Block)
+{
+    return (pMap[Block / 8] >> (Block % 8)) & 1u;
+}
+
+static void SetBlock(uint8_t *pMap, const unsigned int Block)
+{
+    pMap[Block / 8] |= 1u << (Block % 8);
+}
+
+static unsigned int CountBlocks(const uint8_t *pMap)
+{
+    unsigned int Count = 0;
+    for (unsigned int i = 0; i < AIRCOPY_BLOCKS; i++)
+        Count += TestBlock(pMap, i);
+    return Count;
+}
+
 static void AIRCOPY_clear()
 {
     for (uint8_t i = 0; i < 15; i++)
     {
         crc[i] = 0;
     }
+    memset(gBlockMap, 0, sizeof(gBlockMap));
+    gNextBlock            = 0;
+    gSendCountdown_10ms   = 1;
+    gEndRetries           = 0;
+    gAwaitingReport       = false;
+    gReportCountdown_10ms = 0;
     #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
         getScreenShot(true);
     #endif
 }
 
-bool AIRCOPY_SendMessage(void)
+static void AIRCOPY_Complete(void)
+{
+    gAircopyState = AIRCOPY_COMPLETE;
+    #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
+        getScreenShot(false);
+    #endif
+}
+
+static void SendFrame(const uint16_t Header)
 {
-    static uint8_t gAircopySendCountdown = 1;
+    g_FSK_Buffer[0]  = 0xABCD;
+    g_FSK_Buffer[1]  = Header;
+    g_FSK_Buffer[34] = CRC_Calculate(&g_FSK_Buffer[1], 2 + 64);
+    g_FSK_Buffer[35] = 0xDCBA;
+
+    for (unsigned int i = 0; i < 34; i++) {
+        g_FSK_Buffer[i + 1] ^= Obfuscation[i % 8];
+    }
+
+    RADIO_SetTxParameters();
+
+    BK4819_SendFSKData(g_FSK_Buffer);
+    BK4819_SetupPowerAmplifier(0, 0);
+    BK4819_ToggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, false);
+}
+
+static void SendBitmap(const uint16_t Header, const uint8_t *pMap)
+{
+    memset(&g_FSK_Buffer[2], 0, 64);
+    memcpy(&g_FSK_Buffer[2], pMap, sizeof(gBlockMap));
+    SendFrame(Header);
+}
+
+static void Listen(void)
+{
+    gFSKWriteIndex = 0;
+    BK4819_PrepareFSKReceive();
+}
+
+static void SendEnd(void)
+{
+    memset(&g_FSK_Buffer[2], 0, 64);
+    SendFrame(AIRCOPY_V2 | AIRCOPY_V2_END);
+
+    gAwaitingReport       = true;
+    gReportCountdown_10ms = aircopy_v2_report_10ms;
+    Listen();
+}
+
+static void SendNextV2(void)
+{
+    uint8_t Fill[sizeof(gBlockMap)];
+    bool    bFill = false;
+
+    for (unsigned int i = 0; i < sizeof(Fill); i++) {
+        Fill[i] = gBlockMap[i] & gBlankMap[i];
+        bFill  |= Fill[i] != 0;
+    }
+
+    if (bFill) {
+        // every blank block still due goes out in a single frame
+        SendBitmap(AIRCOPY_V2 | AIRCOPY_V2_FILL, Fill);
+        for (unsigned int i = 0; i < sizeof(Fill); i++)
+            gBlockMap[i] &= ~Fill[i];
+    } else {
+        while (gNextBlock < AIRCOPY_BLOCKS && !TestBlock(gBlockMap, gNextBlock))
+            gNextBlock++;
+
+        if (gNextBlock == AIRCOPY_BLOCKS) {
+            SendEnd();
+            return;
+        }
+
+        EEPROM_ReadBuffer(gNextBlock << 6, &g_FSK_Buffer[2], 64);
+        SendFrame(AIRCOPY_V2 | AIRCOPY_V2_DATA | gNextBlock);
+        gBlockMap[gNextBlock / 8] &= ~(1u << (gNextBlock % 8));
+    }
+
+    gAirCopyBlockNumber = AIRCOPY_BLOCKS - CountBlocks(gBlockMap);
+}
 
+static bool ReportMissing(void)
+{
+    uint8_t Missing[sizeof(gBlockMap)];
+
+    for (unsigned int i = 0; i < sizeof(Missing); i++)
+        Missing[i] = ~gBlockMap[i];
+#if AIRCOPY_BLOCKS % 8
+    Missing[sizeof(Missing) - 1] &= (1u << (AIRCOPY_BLOCKS % 8)) - 1;
+#endif
+
+    SendBitmap(AIRCOPY_V2 | AIRCOPY_V2_NACK, Missing);
+
+    return CountBlocks(Missing) == 0;
+}
+
+bool AIRCOPY_IsListening(void)
+{
+    return gAirCopyIsSendMode == 0 || gAwaitingReport;
+}
+
+bool AIRCOPY_SendMessage(void)
+{
     if (gAircopyState != AIRCOPY_TRANSFER) {
         return 1;
     }
 
-    if (--gAircopySendCountdown) {
-        return 1;
+    if (gAirCopyIsSendMode == 0) {
+        // v2 receiver answering an END frame, after giving the sender time to turn around
+        if (gReportCountdown_10ms == 0 || --gReportCountdown_10ms) {
+            return 1;
+        }
+
+        if (ReportMissing()) {
+            AIRCOPY_Complete();
+        } else {
+            Listen();
+        }
+        return 0;
     }
 
-    g_FSK_Buffer[1] = (gAirCopyBlockNumber & 0x3FF) << 6;
+    if (gAwaitingReport) {
+        if (--gReportCountdown_10ms) {
+            return 1;
+        }
 
-    EEPROM_ReadBuffer(g_FSK_Buffer[1], &g_FSK_Buffer[2], 64);
+        gAwaitingReport = false;
+        gErrorsDuringAirCopy++;
 
-    g_FSK_Buffer[34] = CRC_Calculate(&g_FSK_Buffer[1], 2 + 64);
+        if (++gEndRetries >= AIRCOPY_V2_RETRIES) {
+            AIRCOPY_Complete();
+        } else {
+            SendEnd();
+        }
+        return 0;
+    }
 
-    for (unsigned int i = 0; i < 34; i++) {
-        g_FSK_Buffer[i + 1] ^= Obfuscation[i % 8];
+    if (--gSendCountdown_10ms) {
+        return 1;
     }
 
-    if (++gAirCopyBlockNumber >= 0x78) {
-        gAircopyState = AIRCOPY_COMPLETE;
-        #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
-            getScreenShot(false);
-        #endif
-        //NVIC_SystemReset();
+    if (gAirCopyIsSendMode == 2) {
+        SendNextV2();
+        gSendCountdown_10ms = aircopy_v2_gap_10ms;
+        return 0;
     }
 
-    RADIO_SetTxParameters();
+    const uint16_t Offset = (gAirCopyBlockNumber & 0x3FF) << 6;
 
-    BK4819_SendFSKData(g_FSK_Buffer);
-    BK4819_SetupPowerAmplifier(0, 0);
-    BK4819_ToggleGpioOut(BK4819_GPIO1_PIN29_PA_ENABLE, false);
+    EEPROM_ReadBuffer(Offset, &g_FSK_Buffer[2], 64);
 
-    gAircopySendCountdown = 30;
+    if (++gAirCopyBlockNumber >= AIRCOPY_BLOCKS) {
+        AIRCOPY_Complete();
+        //NVIC_SystemReset();
+    }
+
+    SendFrame(Offset);
+
+    gSendCountdown_10ms = 30;
 
     return 0;
 }
 
+static void StoreBlock(const unsigned int Block, const uint16_t *pData)
+{
+    static const uint16_t Blank[4] = { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF };
+    uint16_t Offset = Block << 6;
+
+    PY25Q16_BeginUpdate();
+    for (unsigned int i = 0; i < 8; i++) {
+        EEPROM_WriteBuffer(Offset, pData ? pData + i * 4 : Blank);
+        Offset += 8;
+    }
+    PY25Q16_CommitUpdate();
+
+    if (!TestBlock(gBlockMap, Block)) {
+        SetBlock(gBlockMap, Block);
+        gAirCopyBlockNumber++;
+    }
+}
+
+static void StorePacketV2(const uint16_t Header)
+{
+    const unsigned int Arg = Header & AIRCOPY_V2_ARG;
+    const uint8_t     *pMap = (const uint8_t *)&g_FSK_Buffer[2];
+
+    switch (Header & AIRCOPY_V2_TYPE) {
+        case AIRCOPY_V2_DATA:
+            if (gAirCopyIsSendMode != 0 || Arg >= AIRCOPY_BLOCKS) {
+                gErrorsDuringAirCopy++;
+                return;
+            }
+            StoreBlock(Arg, &g_FSK_Buffer[2]);
+            break;
+
+        case AIRCOPY_V2_FILL:
+            if (gAirCopyIsSendMode != 0) {
+                return;
+            }
+            PY25Q16_BeginUpdate();
+            for (unsigned int i = 0; i < AIRCOPY_BLOCKS; i++) {
+                if (TestBlock(pMap, i))
+                    StoreBlock(i, NULL);
+            }
+            PY25Q16_CommitUpdate();
+            break;
+
+        case AIRCOPY_V2_END:
+            if (gAirCopyIsSendMode == 0)
+                gReportCountdown_10ms = aircopy_v2_turnaround_10ms;
+            break;
+
+        case AIRCOPY_V2_NACK:
+            if (!gAwaitingReport) {
+                return;
+            }
+            gAwaitingReport     = false;
+            gEndRetries         = 0;
+            gNextBlock          = 0;
+            gSendCountdown_10ms = aircopy_v2_turnaround_10ms;
+            memcpy(gBlockMap, pMap, sizeof(gBlockMap));
+            gAirCopyBlockNumber = AIRCOPY_BLOCKS - CountBlocks(gBlockMap);
+            if (gAirCopyBlockNumber == AIRCOPY_BLOCKS)
+                AIRCOPY_Complete();
+            break;
+
+        default:
+            gErrorsDuringAirCopy++;
+            break;
+    }
+}
+
 void AIRCOPY_StorePacket(void)
 {
     if (gFSKWriteIndex < 36) {
@@ -127,23 +367,27 @@ void AIRCOPY_StorePacket(void)
 
     uint16_t Offset = g_FSK_Buffer[1];
 
-    if (Offset >= 0x1E00) {
+    if (Offset & AIRCOPY_V2) {
+        StorePacketV2(Offset);
+        return;
+    }
+
+    if (Offset >= 0x1E00 || gAirCopyIsSendMode != 0) {
         gErrorsDuringAirCopy++;
         return;
     }
 
     const uint16_t *pData = &g_FSK_Buffer[2];
+    PY25Q16_BeginUpdate();
     for (unsigned int i = 0; i < 8; i++) {
         EEPROM_WriteBuffer(Offset, pData);
         pData += 4;
         Offset += 8;
     }
+    PY25Q16_CommitUpdate();
 
     if (Offset == 0x1E00) {
-        gAircopyState = AIRCOPY_COMPLETE;
-        #ifdef ENABLE_FEAT_F4HWN_SCREENSHOT
-            getScreenShot(false);
-        #endif
+        AIRCOPY_Complete();
     }
 
     gAirCopyBlockNumber++;
@@ -223,7 +467,8 @@ static void AIRCOPY_Key_EXIT(bool bKeyPressed, bool bKeyHeld)
     gRequestDisplayScreen = DISPLAY_AIRCOPY;
 }
 
-static void AIRCOPY_Key_MENU(bool bKeyPressed, bool bKeyHeld)
+// MENU sends v1 frames for older receivers, STAR sends v2
+static void AIRCOPY_Key_MENU(bool bKeyPressed, bool bKeyHeld, uint8_t SendMode)
 {
     if (bKeyHeld || !bKeyPressed) {
         return;
@@ -233,13 +478,24 @@ static void AIRCOPY_Key_MENU(bool bKeyPressed, bool bKeyHeld)
     gFSKWriteIndex = 0;
     gAirCopyBlockNumber = 0;
     gInputBoxIndex = 0;
-    gAirCopyIsSendMode = 1;
-    g_FSK_Buffer[0] = 0xABCD;
-    g_FSK_Buffer[1] = 0;
-    g_FSK_Buffer[35] = 0xDCBA;
+    gAirCopyIsSendMode = SendMode;
 
     AIRCOPY_clear();
 
+    if (SendMode == 2) {
+        memset(gBlankMap, 0, sizeof(gBlankMap));
+        for (unsigned int i = 0; i < AIRCOPY_BLOCKS; i++) {
+            bool bBlank = true;
+
+            SetBlock(gBlockMap, i);
+            EEPROM_ReadBuffer(i << 6, &g_FSK_Buffer[2], 64);
+            for (unsigned int j = 0; j < 32 && bBlank; j++)
+                bBlank = g_FSK_Buffer[2 + j] == 0xFFFF;
+            if (bBlank)
+                SetBlock(gBlankMap, i);
+        }
+    }
+
     GUI_DisplayScreen();
 
     gAircopyState = AIRCOPY_TRANSFER;
@@ -261,7 +517,10 @@ void AIRCOPY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
         AIRCOPY_Key_DIGITS(Key, bKeyPressed, bKeyHeld);
         break;
     case KEY_MENU:
-        AIRCOPY_Key_MENU(bKeyPressed, bKeyHeld);
+        AIRCOPY_Key_MENU(bKeyPressed, bKeyHeld, 1);
+        break;
+    case KEY_STAR:
+        AIRCOPY_Key_MENU(bKeyPressed, bKeyHeld, 2);
         break;
     case KEY_EXIT:
         AIRCOPY_Key_EXIT(bKeyPressed, bKeyHeld);
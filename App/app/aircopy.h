@@ -33,10 +33,11 @@ typedef enum AIRCOPY_State_t AIRCOPY_State_t;
 extern AIRCOPY_State_t gAircopyState;
 extern uint16_t        gAirCopyBlockNumber;
 extern uint16_t        gErrorsDuringAirCopy;
-extern uint8_t         gAirCopyIsSendMode;
+extern uint8_t         gAirCopyIsSendMode;    // 0 receive, 1 send v1, 2 send v2
 
 extern uint16_t        g_FSK_Buffer[36];
 
+bool AIRCOPY_IsListening(void);
 bool AIRCOPY_SendMessage(void);
 void AIRCOPY_StorePacket(void);
 void AIRCOPY_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
@@ -23,6 +23,9 @@
 #include "app/main.h"
 #include "app/menu.h"
 #include "app/scanner.h"
+#ifdef ENABLE_PRIORITY_WATCH
+    #include "app/watch.h"
+#endif
 #if defined(ENABLE_UART) || defined(ENABLE_USB)
     #include "app/uart.h"
     #include "scheduler.h"
@@ -47,6 +50,8 @@
 #include "frequencies.h"
 #include "functions.h"
 #include "helper/battery.h"
+#include "helper/powersave.h"
+#include "helper/profile.h"
 #include "misc.h"
 #include "radio.h"
 #include "settings.h"
@@ -66,11 +71,25 @@
 #endif
 
 static bool flagSaveVfo;
-static bool flagSaveSettings;
+static uint8_t flagSaveSettings;
 static bool flagSaveChannel;
 
 static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
 
+#ifdef ENABLE_PROFILER
+typedef struct {
+    KEY_Code_t Key;
+    uint8_t    Hold_10ms;
+    uint8_t    Gap_10ms;
+} InjectedKey_t;
+
+static InjectedKey_t InjectQueue[8];
+static uint8_t       InjectHead;
+static uint8_t       InjectCount;
+static uint8_t       InjectTimer;
+static bool          InjectReleasing;
+#endif
+
 
 
 
@@ -597,7 +616,13 @@ static void DualwatchAlternate(void)
         }
     }
 
-    RADIO_SetupRegisters(false);
+    PROFILE_BEGIN(PROFILE_DUAL_WATCH);
+    RADIO_SwapRxRegisters();
+    PROFILE_END(PROFILE_DUAL_WATCH);
+
+    #ifdef ENABLE_PRIORITY_WATCH
+        WATCH_Visit(gEeprom.RX_VFO ? WATCH_SLOT_VFO_B : WATCH_SLOT_VFO_A);
+    #endif
 
     #ifdef ENABLE_NOAA
         gDualWatchCountdown_10ms = gIsNoaaMode ? dual_watch_count_noaa_10ms : dual_watch_count_toggle_10ms;
@@ -650,37 +675,8 @@ static void CheckRadioInterrupts(void)
 
         if (interrupts.dtmf5ToneFound) {    
             const char c = DTMF_GetCharacter(BK4819_GetDTMF_5TONE_Code()); 
-            if (c != 0xff) {
-                if (gCurrentFunction != FUNCTION_TRANSMIT) {
-                    if (gSetting_live_DTMF_decoder) {
-                        size_t len = strlen(gDTMF_RX_live);
-                        if (len >= sizeof(gDTMF_RX_live) - 1) { 
-                            memmove(&gDTMF_RX_live[0], &gDTMF_RX_live[1], sizeof(gDTMF_RX_live) - 1);
-                            len--;
-                        }
-                        gDTMF_RX_live[len++]  = c;
-                        gDTMF_RX_live[len]    = 0;
-                        gDTMF_RX_live_timeout = DTMF_RX_live_timeout_500ms;  
-                        gUpdateDisplay        = true;
-                    }
-
-#ifdef ENABLE_DTMF_CALLING
-                    if (gRxVfo->DTMF_DECODING_ENABLE || gSetting_KILLED) {
-                        if (gDTMF_RX_index >= sizeof(gDTMF_RX) - 1) { 
-                            memmove(&gDTMF_RX[0], &gDTMF_RX[1], sizeof(gDTMF_RX) - 1);
-                            gDTMF_RX_index--;
-                        }
-                        gDTMF_RX[gDTMF_RX_index++] = c;
-                        gDTMF_RX[gDTMF_RX_index]   = 0;
-                        gDTMF_RX_timeout           = DTMF_RX_timeout_500ms;  
-                        gDTMF_RX_pending           = true;
-                        
-                        SYSTEM_DelayMs(3);
-                        DTMF_HandleRequest();
-                    }
-#endif
-                }
-            }
+            if (c != 0xff && gCurrentFunction != FUNCTION_TRANSMIT)
+                DTMF_PushRxEvent(c);
         }
 
         if (interrupts.cssTailFound)
@@ -730,6 +726,7 @@ static void CheckRadioInterrupts(void)
 
         if (interrupts.sqlLost) {
             g_SquelchLost = true;
+            POWERSAVE_Activity();
             BK4819_ToggleGpioOut(BK4819_GPIO6_PIN2_GREEN, true);
             #ifdef ENABLE_FEAT_F4HWN_RX_TX_TIMER
                 gRxTimerCountdown_500ms = 7200;
@@ -745,7 +742,7 @@ static void CheckRadioInterrupts(void)
         if (interrupts.fskFifoAlmostFull &&
             gScreenToDisplay == DISPLAY_AIRCOPY &&
             gAircopyState == AIRCOPY_TRANSFER &&
-            gAirCopyIsSendMode == 0)
+            AIRCOPY_IsListening())
         {
             for (unsigned int i = 0; i < 4; i++) {
                 g_FSK_Buffer[gFSKWriteIndex++] = BK4819_ReadRegister(BK4819_REG_5F);
@@ -770,6 +767,14 @@ void APP_EndTransmission(void)
     }
 }
 
+void APP_ReleaseTransmitter(void)
+{
+    if (gEeprom.REPEATER_TAIL_TONE_ELIMINATION == 0 && !AUDIO_IsTonePlaying())
+        FUNCTION_Select(FUNCTION_FOREGROUND);
+    else    // the countdown holds until the roger has played out
+        gRTTECountdown_10ms = MAX(gEeprom.REPEATER_TAIL_TONE_ELIMINATION * 10, 1);
+}
+
 #ifdef ENABLE_VOX
 static void HandleVox(void)
 {
@@ -811,13 +816,7 @@ static void HandleVox(void)
             }
             else {
                 APP_EndTransmission();
-
-                if (gEeprom.REPEATER_TAIL_TONE_ELIMINATION == 0) {
-                    
-                        FUNCTION_Select(FUNCTION_FOREGROUND);
-                }
-                else
-                    gRTTECountdown_10ms = gEeprom.REPEATER_TAIL_TONE_ELIMINATION * 10;
+                APP_ReleaseTransmitter();
             }
 
             gUpdateStatus        = true;
@@ -900,7 +899,7 @@ void APP_Update(void)
             if(gSetting_set_tot == 1 || gSetting_set_tot == 3)
             {
                 
-                BK4819_PlaySingleTone(gTxTimeoutToneAlert, 30, 1, true);
+                AUDIO_PlayTxAlert(gTxTimeoutToneAlert);
                 gTxTimeoutToneAlert += 100;
             }
         }
@@ -990,6 +989,9 @@ void APP_Update(void)
         && gScheduleDualWatch
         && gScanStateDir == SCAN_OFF
         && !gPttIsPressed
+#ifdef ENABLE_PRIORITY_WATCH
+        && !WATCH_IsPeeking()
+#endif
         && gCurrentFunction != FUNCTION_POWER_SAVE
 #ifdef ENABLE_VOICE
         && gVoiceWriteIndex == 0
@@ -1076,6 +1078,7 @@ void APP_Update(void)
             }
 
             FUNCTION_Init();
+            POWERSAVE_Wake();
 
             gPowerSave_10ms = power_save1_10ms; 
             gRxIdleMode     = false;            
@@ -1084,18 +1087,7 @@ void APP_Update(void)
         {   
             
 
-#ifdef ENABLE_FEAT_F4HWN_SLEEP
-            if(gWakeUp)
-            {
-                gPowerSave_10ms = gEeprom.BATTERY_SAVE * 200; 
-            }
-            else
-            {
-                gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
-            }
-#else
-            gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
-#endif
+            gPowerSave_10ms = POWERSAVE_StartSleep_10ms();
             gRxIdleMode     = true;
             goToSleep = false;
 
@@ -1118,6 +1110,60 @@ void APP_Update(void)
 }
 
 
+#ifdef ENABLE_PROFILER
+bool APP_InjectKey(KEY_Code_t Key, uint8_t Hold_10ms, uint8_t Gap_10ms)
+{
+    if (Key == KEY_PTT || Key >= KEY_INVALID || InjectCount >= ARRAY_SIZE(InjectQueue))
+        return false;
+
+    // both edges have to survive the debounce in CheckKeys
+    if (Hold_10ms <= key_debounce_10ms)
+        Hold_10ms = key_debounce_10ms + 1;
+    if (Gap_10ms <= key_debounce_10ms)
+        Gap_10ms = key_debounce_10ms + 1;
+
+    const uint8_t i = (InjectHead + InjectCount) % ARRAY_SIZE(InjectQueue);
+    InjectQueue[i].Key       = Key;
+    InjectQueue[i].Hold_10ms = Hold_10ms;
+    InjectQueue[i].Gap_10ms  = Gap_10ms;
+
+    InjectCount++;
+    return true;
+}
+
+uint8_t APP_InjectPending(void)
+{
+    return InjectCount;
+}
+
+// replaces the keypad reading while an injected key is being pressed or released
+static KEY_Code_t InjectedKey(KEY_Code_t Key)
+{
+    if (InjectCount == 0)
+        return Key;
+
+    const InjectedKey_t *pKey = &InjectQueue[InjectHead];
+
+    if (++InjectTimer <= (InjectReleasing ? pKey->Gap_10ms : pKey->Hold_10ms))
+        return InjectReleasing ? KEY_INVALID : pKey->Key;
+
+    InjectTimer = 1;
+    if (!InjectReleasing) {
+        InjectReleasing = true;
+        return KEY_INVALID;
+    }
+
+    InjectReleasing = false;
+    InjectHead = (InjectHead + 1) % ARRAY_SIZE(InjectQueue);
+    InjectCount--;
+    if (InjectCount == 0) {
+        InjectTimer = 0;
+        return Key;
+    }
+    return InjectQueue[InjectHead].Key;
+}
+#endif
+
 static void CheckKeys(void)
 {
 #ifdef ENABLE_DTMF_CALLING
@@ -1247,8 +1293,54 @@ static void CheckKeys(void)
 
 
     
+#ifdef ENABLE_KEYBOARD_SCAN_IRQ
+    KEY_Message_t Message;
+
+#ifdef ENABLE_PROFILER
+    const bool bInjecting = InjectCount > 0;
+    KEYBOARD_SetOverride(bInjecting, InjectedKey(KEY_INVALID));
+#endif
+
+    while (KEYBOARD_GetEvent(&Message))
+    {
+        const KEY_Code_t Key = Message.Key;
+
+        boot_counter_10ms = 0;
+
+        switch (Message.Event)
+        {
+            case KEY_EVENT_PRESS:
+                if (gKeyReading1 != KEY_INVALID)
+                    ProcessKey(gKeyReading1, false, gKeyBeingHeld);
+                gKeyReading1  = Key;
+                gKeyBeingHeld = false;
+                ProcessKey(Key, true, false);
+                break;
+
+            case KEY_EVENT_HOLD:
+            case KEY_EVENT_REPEAT:
+                if (Key != gKeyReading1)
+                    break;
+                gKeyBeingHeld = true;
+                ProcessKey(Key, true, true);
+                break;
+
+            case KEY_EVENT_RELEASE:
+                if (Key != gKeyReading1)
+                    break;
+                ProcessKey(Key, false, gKeyBeingHeld);
+                gKeyReading1  = KEY_INVALID;
+                gKeyBeingHeld = false;
+                break;
+        }
+    }
+#else
     KEY_Code_t Key = KEYBOARD_Poll();
 
+#ifdef ENABLE_PROFILER
+    Key = InjectedKey(Key);
+#endif
+
     if (Key != KEY_INVALID) 
         boot_counter_10ms = 0;   
 
@@ -1311,6 +1403,7 @@ static void CheckKeys(void)
         gDebounceCounter = key_repeat_delay_10ms+1;
 
     }
+#endif
 }
 
 void APP_TimeSlice10ms(void)
@@ -1318,6 +1411,8 @@ void APP_TimeSlice10ms(void)
     gNextTimeslice = false;
     gFlashLightBlinkCounter++;
 
+    AUDIO_ToneTimeSlice10ms();
+
 #ifdef ENABLE_UART
     if (UART_IsCommandAvailable(UART_PORT_UART)) {
         
@@ -1329,8 +1424,30 @@ void APP_TimeSlice10ms(void)
     if (gReducedService)
         return;
 
-    if (gCurrentFunction != FUNCTION_POWER_SAVE || !gRxIdleMode)
+    if (gCurrentFunction != FUNCTION_POWER_SAVE || !gRxIdleMode) {
+        PROFILE_BEGIN(PROFILE_RADIO_IRQ);
         CheckRadioInterrupts();
+        PROFILE_END(PROFILE_RADIO_IRQ);
+    }
+
+    DTMF_TimeSlice10ms();
+
+#ifdef ENABLE_VOICE
+    AUDIO_VoiceTimeSlice10ms();
+#endif
+
+#ifdef ENABLE_PRIORITY_WATCH
+    WATCH_TimeSlice10ms();
+#endif
+
+#ifdef ENABLE_AM_FIX__
+    if (gRxVfo->Modulation == MODULATION_AM
+    #ifdef ENABLE_PRIORITY_WATCH
+        && !WATCH_IsPeeking()
+    #endif
+    )
+        AM_fix_10ms(gEeprom.RX_VFO);
+#endif
 
     if (gCurrentFunction == FUNCTION_TRANSMIT)
     {   
@@ -1346,6 +1463,8 @@ void APP_TimeSlice10ms(void)
     if (gUpdateDisplayCurrent) {
         gUpdateDisplay = false;
         GUI_DisplayScreen();
+    } else if (gMainWidgetsDirty) {
+        UI_MAIN_DisplayWidgets();
     }
 
     if (gUpdateStatusCurrent) {
@@ -1428,7 +1547,7 @@ void APP_TimeSlice10ms(void)
         }
 #endif
         
-        if (gRTTECountdown_10ms > 0) {
+        if (gRTTECountdown_10ms > 0 && !AUDIO_IsTonePlaying()) {
             if (--gRTTECountdown_10ms == 0) {
                 
                     FUNCTION_Select(FUNCTION_FOREGROUND);
@@ -1448,17 +1567,21 @@ void APP_TimeSlice10ms(void)
     }
 #endif
 
+    PROFILE_BEGIN(PROFILE_SCANNER);
     SCANNER_TimeSlice10ms();
+    PROFILE_END(PROFILE_SCANNER);
 
 #ifdef ENABLE_AIRCOPY
-    if (gScreenToDisplay == DISPLAY_AIRCOPY && gAircopyState == AIRCOPY_TRANSFER && gAirCopyIsSendMode == 1) {
+    if (gScreenToDisplay == DISPLAY_AIRCOPY && gAircopyState == AIRCOPY_TRANSFER) {
         if (!AIRCOPY_SendMessage()) {
             GUI_DisplayScreen();
         }
     }
 #endif
 
+    PROFILE_BEGIN(PROFILE_KEYS);
     CheckKeys();
+    PROFILE_END(PROFILE_KEYS);
 }
 
 void cancelUserInputModes(void)
@@ -1542,6 +1665,12 @@ void APP_TimeSlice500ms(void)
             DTMF_clear_RX();
 #endif
 
+#ifdef ENABLE_DTMF_LOG
+    DTMF_TimeSlice500ms();
+#endif
+
+    GUI_TimeSlice500ms();
+
     
 
 #ifdef ENABLE_FMRADIO
@@ -1567,8 +1696,8 @@ void APP_TimeSlice500ms(void)
         
         ST7565_FixInterfGlitch();
         BK4819_ToggleGpioOut(BK4819_GPIO5_PIN1_RED, false);
-        gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
         gWakeUp = false;
+        gPowerSave_10ms = POWERSAVE_GetSleep_10ms();
     }
 
     #ifdef ENABLE_AIRCOPY
@@ -1632,7 +1761,9 @@ void APP_TimeSlice500ms(void)
 
     
 
+#ifndef ENABLE_BATTERY_ESTIMATOR
     if (gCurrentFunction != FUNCTION_TRANSMIT)
+#endif
     {
 
         if ((gBatteryCheckCounter & 1) == 0)
@@ -1762,10 +1893,12 @@ void APP_TimeSlice500ms(void)
 #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
 static void ALARM_Off(void)
 {
+    const bool bTxAlarm = gAlarmState == ALARM_STATE_TXALARM || gAlarmState == ALARM_STATE_TX1750;
+
     AUDIO_AudioPathOff();
     gEnableSpeaker = false;
 
-    if (gAlarmState == ALARM_STATE_TXALARM || gAlarmState == ALARM_STATE_TX1750) {
+    if (bTxAlarm) {
         RADIO_SendEndOfTransmission();
     }
 
@@ -1775,9 +1908,12 @@ static void ALARM_Off(void)
     gVoxResumeCountdown = 80;
 #endif
 
-    SYSTEM_DelayMs(5);
+    // a playing roger sets the registers up itself when it is done
+    if (!bTxAlarm || !AUDIO_IsTonePlaying()) {
+        SYSTEM_DelayMs(5);
 
-    RADIO_SetupRegisters(true);
+        RADIO_SetupRegisters(true);
+    }
 
     if (gScreenToDisplay != DISPLAY_MENU)     
         gRequestDisplayScreen = DISPLAY_MAIN;
@@ -1786,6 +1922,10 @@ static void ALARM_Off(void)
 
 static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 {
+    #ifdef ENABLE_PROFILER
+    PROFILE_KeyEvent(Key, bKeyPressed, bKeyHeld);
+    #endif
+
     #ifdef ENABLE_FEAT_F4HWN_SLEEP
     if(gWakeUp)
     {
@@ -1827,8 +1967,8 @@ static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
         }
 
         if (flagSaveSettings) {
-            SETTINGS_SaveSettings();
-            flagSaveSettings = false;
+            SETTINGS_SaveSettingsRecords(flagSaveSettings);
+            flagSaveSettings = 0;
         }
 
 #ifdef ENABLE_FMRADIO
@@ -2041,11 +2181,7 @@ static void ProcessKey(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
 #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
         else if ((!bKeyHeld && bKeyPressed) || (gAlarmState == ALARM_STATE_TX1750 && bKeyHeld && !bKeyPressed)) {
             ALARM_Off();
-
-            if (gEeprom.REPEATER_TAIL_TONE_ELIMINATION == 0)
-                FUNCTION_Select(FUNCTION_FOREGROUND);
-            else
-                gRTTECountdown_10ms = gEeprom.REPEATER_TAIL_TONE_ELIMINATION * 10;
+            APP_ReleaseTransmitter();
 
             if (Key == KEY_PTT)
                 gPttWasPressed  = true;
@@ -2094,12 +2230,14 @@ Skip:
         gFlagAcceptSetting  = false;
     }
 
-    if (gRequestSaveSettings) {
+    if (gRequestSaveSettings || gRequestSaveRecords) {
+        const uint8_t Records = gRequestSaveSettings ? SETTINGS_RECORD_ALL : gRequestSaveRecords;
         if (!bKeyHeld)
-            SETTINGS_SaveSettings();
+            SETTINGS_SaveSettingsRecords(Records);
         else
-            flagSaveSettings = 1;
+            flagSaveSettings |= Records;
         gRequestSaveSettings = false;
+        gRequestSaveRecords  = 0;
         gUpdateStatus        = true;
     }
 
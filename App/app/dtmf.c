@@ -26,11 +26,17 @@
 #include "driver/bk4819.h"
 #include "driver/eeprom.h"
 #include "driver/gpio.h"
+#ifdef ENABLE_DTMF_LOG
+    #include "driver/py25q16.h"
+#endif
 #include "driver/system.h"
 #include "dtmf.h"
 #include "external/printf/printf.h"
+#include "functions.h"
 #include "misc.h"
+#include "scheduler.h"
 #include "settings.h"
+#include "ui/main.h"
 #include "ui/ui.h"
 
 char              gDTMF_String[15];
@@ -67,6 +73,31 @@ bool              gDTMF_IsGroupCall;
 #endif
 DTMF_ReplyState_t gDTMF_ReplyState;
 
+#define DTMF_EVENT_QUEUE_SIZE 16   // power of two
+
+typedef struct {
+    char     code;
+    uint32_t time_10ms;
+} DTMF_Event_t;
+
+static DTMF_Event_t     eventQueue[DTMF_EVENT_QUEUE_SIZE];
+static volatile uint8_t eventHead;   // written by the producer only
+static volatile uint8_t eventTail;   // written by the consumer only
+uint16_t                gDTMF_EventsDropped;
+
+#ifdef ENABLE_DTMF_LOG
+#define DTMF_LOG_ADDR        0x011000
+#define DTMF_LOG_SECTORS     2
+#define DTMF_LOG_SECTOR_SIZE 0x1000
+#define DTMF_LOG_PER_SECTOR  (DTMF_LOG_SECTOR_SIZE / sizeof(DTMF_LogRecord_t))
+
+static DTMF_LogRecord_t logRecord;
+static uint32_t         lastEvent_10ms;
+static uint16_t         logSlot = 0xffff;    // next free record, 0xffff until located
+static uint16_t         logSeq;
+static bool             logEraseDue;         // logSlot starts a sector that still holds old records
+#endif
+
 #ifdef ENABLE_DTMF_CALLING
 void DTMF_clear_RX(void)
 {
@@ -146,24 +177,59 @@ bool DTMF_GetContact(const int Index, char *pContact)
     return (pContact[0] >= ' ' && pContact[0] < 127);
 }
 
-bool DTMF_FindContact(const char *pContact, char *pResult)
+typedef struct {
+    char    id[3];
+    uint8_t slot;
+} DTMF_ContactIndex_t;
+
+// contacts sorted by ID (then slot), only the slots before the first empty one
+static DTMF_ContactIndex_t gContactIndex[MAX_DTMF_CONTACTS];
+static uint8_t             gContactCount;
+
+void DTMF_BuildContactIndex(void)
 {
-    pResult[0] = 0;
+    gContactCount = 0;
 
     for (unsigned int i = 0; i < MAX_DTMF_CONTACTS; i++) {
         char Contact[16];
         if (!DTMF_GetContact(i, Contact)) {
-            return false;
+            break;
         }
 
-        if (memcmp(pContact, Contact + 8, 3) == 0) {
-            memcpy(pResult, Contact, 8);
-            pResult[8] = 0;
-            return true;
+        // insertion sort, equal IDs keep the lower slot first
+        unsigned int j = gContactCount++;
+        while (j > 0 && memcmp(gContactIndex[j - 1].id, Contact + 8, 3) > 0) {
+            gContactIndex[j] = gContactIndex[j - 1];
+            j--;
         }
+
+        memcpy(gContactIndex[j].id, Contact + 8, 3);
+        gContactIndex[j].slot = i;
     }
+}
 
-    return false;
+bool DTMF_FindContact(const char *pContact, char *pResult)
+{
+    unsigned int lo = 0;
+    unsigned int hi = gContactCount;
+
+    pResult[0] = 0;
+
+    while (lo < hi) {
+        const unsigned int mid = (lo + hi) / 2;
+        if (memcmp(gContactIndex[mid].id, pContact, 3) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo == gContactCount || memcmp(gContactIndex[lo].id, pContact, 3) != 0) {
+        return false;
+    }
+
+    EEPROM_ReadBuffer(0x1C00 + (gContactIndex[lo].slot * 16), pResult, 8);
+    pResult[8] = 0;
+    return true;
 }
 
 #endif
@@ -496,3 +562,193 @@ void DTMF_Reply(void)
 
     BK4819_ExitDTMF_TX(false);
 }
+
+void DTMF_PushRxEvent(const char code)
+{
+    const uint8_t head = eventHead;
+
+    if ((uint8_t)(head - eventTail) >= DTMF_EVENT_QUEUE_SIZE) {
+        gDTMF_EventsDropped++;
+        return;
+    }
+
+    eventQueue[head % DTMF_EVENT_QUEUE_SIZE].code      = code;
+    eventQueue[head % DTMF_EVENT_QUEUE_SIZE].time_10ms = gGlobalSysTickCounter;
+    eventHead = head + 1;
+}
+
+#ifdef ENABLE_DTMF_LOG
+static uint32_t LogAddress(unsigned int slot)
+{
+    return DTMF_LOG_ADDR + (slot / DTMF_LOG_PER_SECTOR) * DTMF_LOG_SECTOR_SIZE
+                         + (slot % DTMF_LOG_PER_SECTOR) * sizeof(DTMF_LogRecord_t);
+}
+
+static uint16_t ReadSeq(unsigned int slot)
+{
+    uint16_t seq;
+    PY25Q16_ReadBuffer(LogAddress(slot), &seq, sizeof(seq));
+    return seq;
+}
+
+// sectors are filled front to back and only ever erased whole, so the
+// free slot is found with a binary search inside the newest sector
+static void LocateLogSlot(void)
+{
+    unsigned int newest   = 0;
+    uint16_t     newestSeq = 0xffff;
+
+    for (unsigned int i = 0; i < DTMF_LOG_SECTORS; i++) {
+        const uint16_t seq = ReadSeq(i * DTMF_LOG_PER_SECTOR);
+        if (seq != 0xffff && (newestSeq == 0xffff || (int16_t)(seq - newestSeq) > 0)) {
+            newest    = i;
+            newestSeq = seq;
+        }
+    }
+
+    unsigned int lo = newest * DTMF_LOG_PER_SECTOR;
+    unsigned int hi = lo + DTMF_LOG_PER_SECTOR;
+
+    if (newestSeq != 0xffff) {
+        lo++;
+        while (lo < hi) {
+            const unsigned int mid = (lo + hi) / 2;
+            if (ReadSeq(mid) == 0xffff)
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        logSeq = ReadSeq(lo - 1) + 1;
+    }
+
+    logSlot     = lo % (DTMF_LOG_SECTORS * DTMF_LOG_PER_SECTOR);
+    logEraseDue = logSlot % DTMF_LOG_PER_SECTOR == 0 && ReadSeq(logSlot) != 0xffff;
+}
+
+static void FlushLog(void)
+{
+    if (logRecord.length == 0)
+        return;
+
+    if (logSlot == 0xffff)
+        LocateLogSlot();
+
+    // normally done ahead by DTMF_TimeSlice500ms
+    if (logEraseDue) {
+        PY25Q16_SectorErase(LogAddress(logSlot));
+        logEraseDue = false;
+    }
+
+#ifdef ENABLE_DTMF_CALLING
+    if (gEeprom.ANI_DTMF_ID[0] != 0 && strstr(logRecord.digits, gEeprom.ANI_DTMF_ID) != NULL)
+        logRecord.flags |= DTMF_LOG_FLAG_ANI;
+#endif
+
+    if (logSeq == 0xffff)
+        logSeq = 0;
+    logRecord.seq = logSeq++;
+
+    PY25Q16_WriteBuffer(LogAddress(logSlot), &logRecord, sizeof(logRecord), true);
+
+    logSlot = (logSlot + 1) % (DTMF_LOG_SECTORS * DTMF_LOG_PER_SECTOR);
+    logEraseDue = logSlot % DTMF_LOG_PER_SECTOR == 0;
+    memset(&logRecord, 0, sizeof(logRecord));
+}
+
+// the digits are polled from the main loop, so the erase waits for a
+// quiet moment instead of stalling it while a sequence may be arriving
+void DTMF_TimeSlice500ms(void)
+{
+    if (logRecord.length > 0 || FUNCTION_IsRx())
+        return;
+
+    if (logSlot == 0xffff)
+        LocateLogSlot();
+
+    if (logEraseDue) {
+        PY25Q16_SectorErase(LogAddress(logSlot));
+        logEraseDue = false;
+    }
+}
+
+unsigned int DTMF_ReadLog(unsigned int index, DTMF_LogRecord_t *pRecords, unsigned int count)
+{
+    const unsigned int slots = DTMF_LOG_SECTORS * DTMF_LOG_PER_SECTOR;
+    unsigned int       n;
+
+    if (logSlot == 0xffff)
+        LocateLogSlot();
+
+    // walk back from the newest record until the sequence numbers break
+    for (n = 0; n < count && index + n < slots; n++) {
+        const unsigned int slot = (logSlot + 2 * slots - 1 - index - n) % slots;
+
+        PY25Q16_ReadBuffer(LogAddress(slot), &pRecords[n], sizeof(pRecords[n]));
+        if (pRecords[n].seq == 0xffff || pRecords[n].seq != (uint16_t)(logSeq - 1 - index - n))
+            break;
+    }
+
+    return n;
+}
+
+uint16_t DTMF_GetLogSeq(void)
+{
+    if (logSlot == 0xffff)
+        LocateLogSlot();
+
+    return logSeq;
+}
+#endif
+
+void DTMF_TimeSlice10ms(void)
+{
+    while (eventTail != eventHead) {
+        const DTMF_Event_t *pEvent = &eventQueue[eventTail % DTMF_EVENT_QUEUE_SIZE];
+        const char          c      = pEvent->code;
+
+#ifdef ENABLE_DTMF_LOG
+        if (logRecord.length > 0 && pEvent->time_10ms - lastEvent_10ms > dtmf_log_gap_10ms)
+            FlushLog();
+
+        if (logRecord.length == 0)
+            logRecord.time_10ms = pEvent->time_10ms;
+        if (logRecord.length < sizeof(logRecord.digits) - 1)
+            logRecord.digits[logRecord.length++] = c;
+        lastEvent_10ms = pEvent->time_10ms;
+#endif
+
+        eventTail++;
+
+        if (gSetting_live_DTMF_decoder) {
+            size_t len = strlen(gDTMF_RX_live);
+            if (len >= sizeof(gDTMF_RX_live) - 1) {
+                memmove(&gDTMF_RX_live[0], &gDTMF_RX_live[1], sizeof(gDTMF_RX_live) - 1);
+                len--;
+            }
+            gDTMF_RX_live[len++]  = c;
+            gDTMF_RX_live[len]    = 0;
+            gDTMF_RX_live_timeout = DTMF_RX_live_timeout_500ms;
+            gMainWidgetsDirty    |= MAIN_WIDGET_DTMF_LIVE;
+        }
+
+#ifdef ENABLE_DTMF_CALLING
+        if (gRxVfo->DTMF_DECODING_ENABLE || gSetting_KILLED) {
+            if (gDTMF_RX_index >= sizeof(gDTMF_RX) - 1) {
+                memmove(&gDTMF_RX[0], &gDTMF_RX[1], sizeof(gDTMF_RX) - 1);
+                gDTMF_RX_index--;
+            }
+            gDTMF_RX[gDTMF_RX_index++] = c;
+            gDTMF_RX[gDTMF_RX_index]   = 0;
+            gDTMF_RX_timeout           = DTMF_RX_timeout_500ms;
+            gDTMF_RX_pending           = true;
+
+            DTMF_HandleRequest();
+        }
+#endif
+    }
+
+#ifdef ENABLE_DTMF_LOG
+    if (logRecord.length > 0 && gGlobalSysTickCounter - lastEvent_10ms > dtmf_log_gap_10ms)
+        FlushLog();
+#endif
+}
@@ -79,6 +79,22 @@ extern char              gDTMF_RX_live[20];
 extern uint8_t           gDTMF_RX_live_timeout;
 
 extern DTMF_ReplyState_t gDTMF_ReplyState;
+extern uint16_t          gDTMF_EventsDropped;
+
+#ifdef ENABLE_DTMF_LOG
+enum {
+    DTMF_LOG_FLAG_ANI = 1u << 0,    // sequence contained our own ANI ID
+};
+
+// one received sequence, closed by an inter-digit gap of dtmf_log_gap_10ms
+typedef struct {
+    uint16_t seq;
+    uint8_t  length;
+    uint8_t  flags;
+    uint32_t time_10ms;             // uptime of the first digit
+    char     digits[24];
+} DTMF_LogRecord_t;
+#endif
 
 bool DTMF_ValidateCodes(char *pCode, const unsigned int size);
 char DTMF_GetCharacter(const unsigned int code);
@@ -86,6 +102,15 @@ void DTMF_clear_input_box(void);
 void DTMF_Append(const char code);
 void DTMF_Reply(void);
 void DTMF_SendEndOfTransmission(void);
+void DTMF_PushRxEvent(const char code);
+void DTMF_TimeSlice10ms(void);
+
+#ifdef ENABLE_DTMF_LOG
+void         DTMF_TimeSlice500ms(void);
+// newest first, index 0 is the latest record; returns how many were read
+unsigned int DTMF_ReadLog(unsigned int index, DTMF_LogRecord_t *pRecords, unsigned int count);
+uint16_t     DTMF_GetLogSeq(void);
+#endif
 
 #ifdef ENABLE_DTMF_CALLING
 
@@ -111,6 +136,7 @@ extern uint8_t           gDTMF_TxStopCountdown_500ms;
 void DTMF_clear_RX(void);
 DTMF_CallMode_t DTMF_CheckGroupCall(const char *pDTMF, const unsigned int size);
 bool DTMF_GetContact(const int Index, char *pContact);
+void DTMF_BuildContactIndex(void);
 bool DTMF_FindContact(const char *pContact, char *pResult);
 void DTMF_HandleRequest(void);
 
@@ -22,7 +22,7 @@
     #define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
 #endif
 
-uint16_t          gFM_Channels[20];
+uint16_t          gFM_Channels[MAX_FM_CHANNELS];
 bool              gFmRadioMode;
 uint8_t           gFmRadioCountdown_500ms;
 volatile uint16_t gFmPlayCountdown_10ms;
@@ -110,6 +110,44 @@ void FM_EraseChannels(void)
     memset(gFM_Channels, 0xFF, sizeof(gFM_Channels));
 }
 
+// Autoscan first sweeps the band reading RSSI only, keeping local peaks as
+// candidates, then runs the full lock check on those, strongest first.
+typedef struct {
+    uint16_t frequency;
+    uint8_t  rssi;
+} FM_Candidate_t;
+
+enum {
+    FM_SWEEP_RSSI = 0,
+    FM_SWEEP_VERIFY
+};
+
+static FM_Candidate_t gCandidates[MAX_FM_CHANNELS + 8];
+static uint8_t        gCandidateCount;
+static uint8_t        gCandidateIndex;
+static uint8_t        gSweepPhase;
+static uint8_t        gSweepRssi[2];
+
+static void AddCandidate(uint16_t Frequency, uint8_t Rssi)
+{
+    unsigned int i = gCandidateCount;
+
+    if (gCandidateCount == ARRAY_SIZE(gCandidates)) {
+        if (Rssi <= gCandidates[--i].rssi)
+            return;
+    }
+    else {
+        gCandidateCount++;
+    }
+
+    // keep the list sorted by strength
+    for (; i > 0 && gCandidates[i - 1].rssi < Rssi; i--)
+        gCandidates[i] = gCandidates[i - 1];
+
+    gCandidates[i].frequency = Frequency;
+    gCandidates[i].rssi      = Rssi;
+}
+
 void FM_Tune(uint16_t Frequency, int8_t Step, bool bFlag)
 {
     AUDIO_AudioPathOff();
@@ -118,6 +156,18 @@ void FM_Tune(uint16_t Frequency, int8_t Step, bool bFlag)
 
     gFmPlayCountdown_10ms = (gFM_ScanState == FM_SCAN_OFF) ? fm_play_countdown_noscan_10ms : fm_play_countdown_scan_10ms;
 
+    if (gFM_AutoScan) {
+        if (gFM_ScanState == FM_SCAN_OFF) {
+            gSweepPhase     = FM_SWEEP_RSSI;
+            gCandidateCount = 0;
+            gSweepRssi[0]   = 0;
+            gSweepRssi[1]   = 0;
+        }
+
+        if (gSweepPhase == FM_SWEEP_RSSI)
+            gFmPlayCountdown_10ms = fm_sweep_settle_10ms;
+    }
+
     gScheduleFM                 = false;
     gFM_FoundFrequency          = false;
     gAskToSave                  = false;
@@ -300,7 +350,7 @@ static void Key_DIGITS(KEY_Code_t Key, uint8_t state)
                     return;
                 }
             }
-            else if (Channel < 20) {
+            else if (Channel < MAX_FM_CHANNELS) {
 #ifdef ENABLE_VOICE
                 gAnotherVoiceID = (VOICE_ID_t)Key;
 #endif
@@ -475,7 +525,7 @@ static void Key_UP_DOWN(uint8_t state, int8_t Step)
 
     if (gAskToSave) {
         gRequestDisplayScreen = DISPLAY_FM;
-        gFM_ChannelPosition   = NUMBER_AddWithWraparound(gFM_ChannelPosition, Step, 0, 19);
+        gFM_ChannelPosition   = NUMBER_AddWithWraparound(gFM_ChannelPosition, Step, 0, MAX_FM_CHANNELS - 1);
         return;
     }
 
@@ -562,37 +612,72 @@ void FM_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
     }
 }
 
-void FM_Play(void)
+static void FM_AutoScanStep(void)
 {
-    if (!FM_CheckFrequencyLock(gEeprom.FM_FrequencyPlaying, BK1080_GetFreqLoLimit(gEeprom.FM_Band))) {
-        if (!gFM_AutoScan) {
-            gFmPlayCountdown_10ms = 0;
-            gFM_FoundFrequency    = true;
+    const uint16_t Frequency = gEeprom.FM_FrequencyPlaying;
+    const uint16_t LoLimit   = BK1080_GetFreqLoLimit(gEeprom.FM_Band);
+    const uint16_t HiLimit   = BK1080_GetFreqHiLimit(gEeprom.FM_Band);
+
+    if (gSweepPhase == FM_SWEEP_RSSI) {
+        const uint8_t Rssi = BK1080_REG_10_GET_RSSI(BK1080_ReadRegister(BK1080_REG_10));
 
-            if (!gEeprom.FM_IsMrMode)
-                gEeprom.FM_SelectedFrequency = gEeprom.FM_FrequencyPlaying;
+        if (gSweepRssi[1] > gSweepRssi[0] && gSweepRssi[1] >= Rssi && gSweepRssi[1] >= fm_sweep_min_rssi)
+            AddCandidate(Frequency - 1, gSweepRssi[1]);
 
-            AUDIO_AudioPathOn();
-            gEnableSpeaker = true;
+        gSweepRssi[0] = gSweepRssi[1];
+        gSweepRssi[1] = Rssi;
 
-            GUI_SelectNextDisplay(DISPLAY_FM);
+        if (Frequency < HiLimit) {
+            FM_Tune(Frequency, 1, false);
             return;
         }
 
-        if (gFM_ChannelPosition < 20)
-            gFM_Channels[gFM_ChannelPosition++] = gEeprom.FM_FrequencyPlaying;
+        if (Rssi > gSweepRssi[0] && Rssi >= fm_sweep_min_rssi)
+            AddCandidate(Frequency, Rssi);
 
-        if (gFM_ChannelPosition >= 20) {
-            FM_PlayAndUpdate();
-            GUI_SelectNextDisplay(DISPLAY_FM);
-            return;
-        }
+        gSweepPhase     = FM_SWEEP_VERIFY;
+        gCandidateIndex = 0;
+    }
+    else {
+        if (!FM_CheckFrequencyLock(Frequency, LoLimit))
+            gFM_Channels[gFM_ChannelPosition++] = Frequency;
+
+        gCandidateIndex++;
     }
 
-    if (gFM_AutoScan && gEeprom.FM_FrequencyPlaying >= BK1080_GetFreqHiLimit(1))
+    if (gCandidateIndex >= gCandidateCount || gFM_ChannelPosition >= ARRAY_SIZE(gFM_Channels)) {
         FM_PlayAndUpdate();
-    else
-        FM_Tune(gEeprom.FM_FrequencyPlaying, gFM_ScanState, false);
+        return;
+    }
+
+    // candidates are not neighbours, keep the adjacent channel checks out of it
+    BK1080_BaseFrequency = 0;
+    FM_Tune(gCandidates[gCandidateIndex].frequency, 1, true);
+}
+
+void FM_Play(void)
+{
+    if (gFM_AutoScan) {
+        FM_AutoScanStep();
+        GUI_SelectNextDisplay(DISPLAY_FM);
+        return;
+    }
+
+    if (!FM_CheckFrequencyLock(gEeprom.FM_FrequencyPlaying, BK1080_GetFreqLoLimit(gEeprom.FM_Band))) {
+        gFmPlayCountdown_10ms = 0;
+        gFM_FoundFrequency    = true;
+
+        if (!gEeprom.FM_IsMrMode)
+            gEeprom.FM_SelectedFrequency = gEeprom.FM_FrequencyPlaying;
+
+        AUDIO_AudioPathOn();
+        gEnableSpeaker = true;
+
+        GUI_SelectNextDisplay(DISPLAY_FM);
+        return;
+    }
+
+    FM_Tune(gEeprom.FM_FrequencyPlaying, gFM_ScanState, false);
 
     GUI_SelectNextDisplay(DISPLAY_FM);
 }
@@ -24,11 +24,13 @@
 #define FM_CHANNEL_UP   0x01
 #define FM_CHANNEL_DOWN 0xFF
 
+#define MAX_FM_CHANNELS 32
+
 enum {
     FM_SCAN_OFF = 0U,
 };
 
-extern uint16_t          gFM_Channels[20];
+extern uint16_t          gFM_Channels[MAX_FM_CHANNELS];
 extern bool              gFmRadioMode;
 extern uint8_t           gFmRadioCountdown_500ms;
 extern volatile uint16_t gFmPlayCountdown_10ms;
@@ -47,6 +47,15 @@
 #include "ui/ui.h"
 #include <stdlib.h>
 
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+bool gNameJumpMode;
+char gNameJumpPrefix[11];
+
+static uint8_t    NameJumpLength;
+static KEY_Code_t NameJumpKey = KEY_INVALID;
+static uint8_t    NameJumpTap;
+#endif
+
 /**
  * @brief Toggle the selected channel's scanlist participation or scan range settings.
  * 
@@ -802,6 +811,20 @@ static void MAIN_Key_MENU(bool bKeyPressed, bool bKeyHeld)
         return;
     }
 
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+    if (!bKeyPressed && gWasFKeyPressed && !gDTMF_InputMode && gInputBoxIndex == 0 &&
+        gScanStateDir == SCAN_OFF && IS_MR_CHANNEL(gTxVfo->CHANNEL_SAVE)) { // F + MENU
+        gWasFKeyPressed       = false;
+        gUpdateStatus         = true;
+        gNameJumpMode         = true;
+        NameJumpLength        = 0;
+        gNameJumpPrefix[0]    = 0;
+        NameJumpKey           = KEY_INVALID;
+        gRequestDisplayScreen = DISPLAY_MAIN;
+        return;
+    }
+#endif
+
     if (!bKeyPressed && !gDTMF_InputMode) { // menu key released
         const bool bFlag = !gInputBoxIndex;
         gInputBoxIndex   = 0;
@@ -1051,6 +1074,138 @@ static void MAIN_Key_UP_DOWN(bool bKeyPressed, bool bKeyHeld, int8_t Direction)
     gPttWasReleased = true;
 }
 
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+static const char *const NameJumpLetters[10] = {
+    "0 ", "1-.", "ABC2", "DEF3", "GHI4", "JKL5", "MNO6", "PQRS7", "TUV8", "WXYZ9"
+};
+
+static void NameJumpTo(uint8_t Channel)
+{
+    gEeprom.MrChannel[gEeprom.TX_VFO]     = Channel;
+    gEeprom.ScreenChannel[gEeprom.TX_VFO] = Channel;
+    gRequestSaveVFO                       = true;
+    gVfoConfigureMode                     = VFO_CONFIGURE_RELOAD;
+    gRequestDisplayScreen                 = DISPLAY_MAIN;
+}
+
+static void NameJumpSearch(void)
+{
+    const int Pos = SETTINGS_FindChannelName(gNameJumpPrefix);
+
+    if (Pos < 0)
+        gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+    else
+        NameJumpTo(gChannelNameIndex.Channel[Pos]);
+}
+
+static void NameJumpStep(int8_t Direction)
+{
+    const ChannelNameIndex_t *pIndex = &gChannelNameIndex;
+    unsigned int              Pos    = 0;
+
+    if (pIndex->Count == 0) {
+        gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+        return;
+    }
+
+    while (Pos < pIndex->Count && pIndex->Channel[Pos] != gTxVfo->CHANNEL_SAVE)
+        Pos++;
+
+    if (Pos == pIndex->Count)   // current channel has no name
+        Pos = (Direction > 0) ? pIndex->Count - 1 : 0;
+
+    Pos = (Pos + pIndex->Count + Direction) % pIndex->Count;
+
+    NameJumpLength     = 0;
+    gNameJumpPrefix[0] = 0;
+    NameJumpKey        = KEY_INVALID;
+
+    NameJumpTo(pIndex->Channel[Pos]);
+}
+
+/**
+ * @brief Handle keys while jumping to an MR channel by name (F + MENU).
+ *
+ * Digits enter the name prefix with multi-tap letters, STAR closes the current
+ * letter, EXIT deletes the last one, UP/DOWN step through the channels in name
+ * order and MENU leaves. Other keys leave the mode and are processed as usual.
+ *
+ * @return true if the key was consumed
+ */
+static bool MAIN_Key_NAME_JUMP(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
+{
+    switch (Key) {
+        case KEY_0...KEY_9:
+        case KEY_STAR:
+        case KEY_EXIT:
+        case KEY_MENU:
+            break;
+        case KEY_UP:
+        case KEY_DOWN:
+            if (bKeyPressed) {
+                gBeepToPlay = BEEP_1KHZ_60MS_OPTIONAL;
+#ifdef ENABLE_NAVIG_LEFT_RIGHT
+                NameJumpStep(Key == KEY_UP ? -1 : 1);
+#else
+                NameJumpStep(Key == KEY_UP ? 1 : -1);
+#endif
+            }
+            return true;
+        default:
+            gNameJumpMode         = false;
+            gRequestDisplayScreen = DISPLAY_MAIN;
+            return false;
+    }
+
+    if (bKeyPressed) {
+        if (!bKeyHeld)
+            gBeepToPlay = BEEP_1KHZ_60MS_OPTIONAL;
+        return true;
+    }
+
+    if (bKeyHeld)   // released after a long press
+        return true;
+
+    if (Key == KEY_MENU || (Key == KEY_EXIT && NameJumpLength == 0)) {
+        gNameJumpMode         = false;
+        gRequestDisplayScreen = DISPLAY_MAIN;
+        return true;
+    }
+
+    if (Key == KEY_STAR) {
+        NameJumpKey = KEY_INVALID;
+        return true;
+    }
+
+    if (Key == KEY_EXIT) {
+        gNameJumpPrefix[--NameJumpLength] = 0;
+        NameJumpKey = KEY_INVALID;
+        NameJumpSearch();
+        return true;
+    }
+
+    const char *pLetters = NameJumpLetters[Key - KEY_0];
+
+    if (Key == NameJumpKey && NameJumpLength > 0) {
+        NameJumpTap = (NameJumpTap + 1) % strlen(pLetters);
+        gNameJumpPrefix[NameJumpLength - 1] = pLetters[NameJumpTap];
+    }
+    else {
+        if (NameJumpLength == sizeof(gNameJumpPrefix) - 1) {
+            gBeepToPlay = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;
+            return true;
+        }
+        NameJumpTap = 0;
+        gNameJumpPrefix[NameJumpLength++] = pLetters[0];
+        gNameJumpPrefix[NameJumpLength]   = 0;
+    }
+
+    NameJumpKey = Key;
+    NameJumpSearch();
+    return true;
+}
+#endif
+
 /**
  * @brief Main keyboard event dispatcher for the radio's main display.
  * 
@@ -1086,6 +1241,11 @@ void MAIN_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld)
     }
 #endif
 
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+    if (gNameJumpMode && MAIN_Key_NAME_JUMP(Key, bKeyPressed, bKeyHeld))
+        return;
+#endif
+
     if (gDTMF_InputMode && bKeyPressed && !bKeyHeld) {
         const char Character = DTMF_GetCharacter(Key);
         if (Character != 0xFF)
@@ -29,6 +29,7 @@
 //   0-9: Channel/frequency digit entry (held=F-key functions)
 //   UP/DOWN: Step frequency or change channel
 //   MENU: Enter settings menu
+//   F+MENU: Jump to MR channel by name (ENABLE_CHANNEL_NAME_INDEX)
 //   EXIT: Cancel input / exit scanner
 //   STAR: Enter DTMF input / CSS tone scan
 //   F: Enable F-key functions (combined with other keys)
@@ -71,6 +72,11 @@
 
 #include "driver/keyboard.h"
 
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+    extern bool gNameJumpMode;
+    extern char gNameJumpPrefix[11];
+#endif
+
 void MAIN_ProcessKeys(KEY_Code_t Key, bool bKeyPressed, bool bKeyHeld);
 void channelMoveSwitch(void);
 
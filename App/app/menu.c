@@ -18,6 +18,7 @@
 #include "driver/keyboard.h"
 #include "frequencies.h"
 #include "helper/battery.h"
+#include "helper/profile.h"
 #include "misc.h"
 #include "settings.h"
 #if defined(ENABLE_OVERLAY)
@@ -96,17 +97,226 @@ void MENU_StopCssScan(void)
     gUpdateStatus = true;
 }
 
+static void MENU_AcceptConfigure(void)
+{
+    gVfoConfigureMode = VFO_CONFIGURE;
+}
+
+static void MENU_AcceptReconfigure(void)
+{
+    gFlagReconfigureVfos = true;
+}
+
+static void MENU_AcceptReload(void)
+{
+    gVfoConfigureMode = VFO_CONFIGURE_RELOAD;
+    gFlagResetVfos    = true;
+}
+
+#ifdef ENABLE_VOICE
+static void MENU_AcceptStatus(void)
+{
+    gUpdateStatus = true;
+}
+#endif
+
+static void MENU_AcceptAutoLock(void)
+{
+    gKeyLockCountdown = gEeprom.AUTO_KEYPAD_LOCK * 30;
+}
+
+static void MENU_AcceptMic(void)
+{
+    SETTINGS_LoadCalibration();
+    gFlagReconfigureVfos = true;
+}
+
+static void MENU_AcceptLiveDecoder(void)
+{
+    gDTMF_RX_live_timeout = 0;
+    memset(gDTMF_RX_live, 0, sizeof(gDTMF_RX_live));
+    if (!gSetting_live_DTMF_decoder)
+        BK4819_DisableDTMF();
+    gFlagReconfigureVfos = true;
+    gUpdateStatus        = true;
+}
+
+static void MENU_AcceptScrambler(void)
+{
+    if (gTxVfo->SCRAMBLING_TYPE > 0 && gSetting_ScrambleEnable)
+        BK4819_EnableScramble(gTxVfo->SCRAMBLING_TYPE - 1);
+    else
+        BK4819_DisableScramble();
+}
+
+#ifdef ENABLE_DTMF_CALLING
+static void MENU_AcceptDtmfDecode(void)
+{
+    DTMF_clear_RX();
+}
+#endif
+
+#ifdef ENABLE_FEAT_F4HWN
+static void MENU_AcceptPower(void)
+{
+    gRequestSaveChannel = 1;
+}
+#endif
+
+#ifdef ENABLE_FEAT_F4HWN_NARROWER
+static void MENU_AcceptNarrower(void)
+{
+    RADIO_SetTxParameters();
+    RADIO_SetupRegisters(true);
+}
+#endif
+
+#define MENU_VALUE(id, var, records, min, max, accept) \
+    { &(var), NULL, accept, id, sizeof(var), records, 0, min, max }
+#define MENU_NAMED(id, var, records, names, accept) \
+    { &(var), names[0], accept, id, sizeof(var), records, sizeof(names[0]), 0, ARRAY_SIZE(names) - 1 }
+#define VFO_FIELD(field) gEeprom.VfoInfo[0].field
+
+static const MENU_Setting_t MenuSettings[] = {
+    MENU_VALUE(MENU_SQL,          gEeprom.SQUELCH_LEVEL,        SETTINGS_RECORD_MAIN, 0, 9, MENU_AcceptConfigure),
+    MENU_VALUE(MENU_TXP,          VFO_FIELD(OUTPUT_POWER),      0, 0, ARRAY_SIZE(gSubMenu_TXP) - 1, NULL),
+    MENU_NAMED(MENU_SFT_D,        VFO_FIELD(TX_OFFSET_FREQUENCY_DIRECTION), 0, gSubMenu_SFT_D, NULL),
+    MENU_VALUE(MENU_TOT,          gEeprom.TX_TIMEOUT_TIMER,     SETTINGS_RECORD_MAIN, 5, 179, NULL),
+    MENU_NAMED(MENU_W_N,          VFO_FIELD(CHANNEL_BANDWIDTH), 0, gSubMenu_W_N, NULL),
+    MENU_NAMED(MENU_SCR,          VFO_FIELD(SCRAMBLING_TYPE),   0, gSubMenu_SCRAMBLER, MENU_AcceptScrambler),
+    MENU_NAMED(MENU_BCL,          VFO_FIELD(BUSY_CHANNEL_LOCK), 0, gSubMenu_OFF_ON, NULL),
+#ifdef ENABLE_FEAT_F4HWN
+    MENU_NAMED(MENU_TX_LOCK,      VFO_FIELD(TX_LOCK),           0, gSubMenu_OFF_ON, NULL),
+#endif
+    MENU_VALUE(MENU_MDF,          gEeprom.CHANNEL_DISPLAY_MODE, SETTINGS_RECORD_MAIN, 0, ARRAY_SIZE(gSubMenu_MDF) - 1, NULL),
+    MENU_VALUE(MENU_SAVE,         gEeprom.BATTERY_SAVE,         SETTINGS_RECORD_MAIN, 0, BATTERY_SAVE_LEN - 1, NULL),
+    MENU_NAMED(MENU_ABR_ON_TX_RX, gSetting_backlight_on_tx_rx,  SETTINGS_RECORD_FLAGS, gSubMenu_RX_TX, NULL),
+    MENU_NAMED(MENU_BEEP,         gEeprom.BEEP_CONTROL,         SETTINGS_RECORD_KEYS, gSubMenu_OFF_ON, NULL),
+#ifdef ENABLE_VOICE
+    MENU_NAMED(MENU_VOICE,        gEeprom.VOICE_PROMPT,         SETTINGS_RECORD_KEYS, gSubMenu_VOICE, MENU_AcceptStatus),
+#endif
+    MENU_VALUE(MENU_SC_REV,       gEeprom.SCAN_RESUME_MODE,     SETTINGS_RECORD_KEYS, 0, 104, NULL),
+    MENU_VALUE(MENU_AUTOLK,       gEeprom.AUTO_KEYPAD_LOCK,     SETTINGS_RECORD_KEYS, 0, 40, MENU_AcceptAutoLock),
+    MENU_NAMED(MENU_STE,          gEeprom.TAIL_TONE_ELIMINATION, SETTINGS_RECORD_MAIN, gSubMenu_OFF_ON, NULL),
+    MENU_VALUE(MENU_RP_STE,       gEeprom.REPEATER_TAIL_TONE_ELIMINATION, SETTINGS_RECORD_KEYS, 0, 10, NULL),
+    MENU_VALUE(MENU_MIC,          gEeprom.MIC_SENSITIVITY,      SETTINGS_RECORD_MAIN, 0, 4, MENU_AcceptMic),
+#ifdef ENABLE_AUDIO_BAR
+    MENU_NAMED(MENU_MIC_BAR,      gSetting_mic_bar,             SETTINGS_RECORD_FLAGS, gSubMenu_OFF_ON, NULL),
+#endif
+    MENU_VALUE(MENU_1_CALL,       gEeprom.CHAN_1_CALL,          SETTINGS_RECORD_MAIN, 0, MR_CHANNEL_LAST, NULL),
+#ifdef ENABLE_FEAT_F4HWN_RESUME_STATE
+    MENU_VALUE(MENU_S_LIST,       gEeprom.SCAN_LIST_DEFAULT,    SETTINGS_RECORD_SCAN | SETTINGS_RECORD_MAIN, 0, 5, NULL),
+#else
+    MENU_VALUE(MENU_S_LIST,       gEeprom.SCAN_LIST_DEFAULT,    SETTINGS_RECORD_SCAN, 0, 5, NULL),
+#endif
+#ifdef ENABLE_ALARM
+    MENU_NAMED(MENU_AL_MOD,       gEeprom.ALARM_MODE,           SETTINGS_RECORD_KEYS, gSubMenu_AL_MOD, NULL),
+#endif
+    MENU_VALUE(MENU_PTT_ID,       VFO_FIELD(DTMF_PTT_ID_TX_MODE), 0, 0, ARRAY_SIZE(gSubMenu_PTT_ID) - 1, NULL),
+    MENU_NAMED(MENU_D_ST,         gEeprom.DTMF_SIDE_TONE,       SETTINGS_RECORD_KEYS, gSubMenu_OFF_ON, NULL),
+#ifdef ENABLE_DTMF_CALLING
+    MENU_NAMED(MENU_D_RSP,        gEeprom.DTMF_DECODE_RESPONSE, SETTINGS_RECORD_KEYS, gSubMenu_D_RSP, NULL),
+    MENU_VALUE(MENU_D_HOLD,       gEeprom.DTMF_auto_reset_time, SETTINGS_RECORD_KEYS, 5, 60, NULL),
+    MENU_NAMED(MENU_D_DCD,        VFO_FIELD(DTMF_DECODING_ENABLE), 0, gSubMenu_OFF_ON, MENU_AcceptDtmfDecode),
+#endif
+    MENU_NAMED(MENU_D_LIVE_DEC,   gSetting_live_DTMF_decoder,   SETTINGS_RECORD_FLAGS, gSubMenu_OFF_ON, MENU_AcceptLiveDecoder),
+    MENU_NAMED(MENU_PONMSG,       gEeprom.POWER_ON_DISPLAY_MODE, SETTINGS_RECORD_KEYS, gSubMenu_PONMSG, NULL),
+    MENU_NAMED(MENU_ROGER,        gEeprom.ROGER,                SETTINGS_RECORD_KEYS, gSubMenu_ROGER, NULL),
+    MENU_NAMED(MENU_BAT_TXT,      gSetting_battery_text,        SETTINGS_RECORD_FLAGS, gSubMenu_BAT_TXT, NULL),
+    MENU_NAMED(MENU_AM,           VFO_FIELD(Modulation),        0, gModulationStr, NULL),
+#ifdef ENABLE_NOAA
+    MENU_NAMED(MENU_NOAA_S,       gEeprom.NOAA_AUTO_SCAN,       SETTINGS_RECORD_MAIN, gSubMenu_OFF_ON, MENU_AcceptReconfigure),
+#endif
+#ifndef ENABLE_FEAT_F4HWN
+    MENU_NAMED(MENU_200TX,        gSetting_200TX,               SETTINGS_RECORD_FLAGS, gSubMenu_OFF_ON, NULL),
+    MENU_NAMED(MENU_350TX,        gSetting_350TX,               SETTINGS_RECORD_FLAGS, gSubMenu_OFF_ON, NULL),
+    MENU_NAMED(MENU_500TX,        gSetting_500TX,               SETTINGS_RECORD_FLAGS, gSubMenu_OFF_ON, NULL),
+#endif
+    MENU_NAMED(MENU_350EN,        gSetting_350EN,               SETTINGS_RECORD_FLAGS, gSubMenu_OFF_ON, MENU_AcceptReload),
+    MENU_NAMED(MENU_SCREN,        gSetting_ScrambleEnable,      SETTINGS_RECORD_FLAGS, gSubMenu_OFF_ON, MENU_AcceptReconfigure),
+#ifdef ENABLE_FEAT_F4HWN_SLEEP
+    MENU_VALUE(MENU_SET_OFF,      gSetting_set_off,             SETTINGS_RECORD_F4HWN, 0, 120, NULL),
+#endif
+#ifdef ENABLE_FEAT_F4HWN
+    MENU_VALUE(MENU_SET_PWR,      gSetting_set_pwr,             SETTINGS_RECORD_F4HWN, 0, ARRAY_SIZE(gSubMenu_SET_PWR) - 1, MENU_AcceptPower),
+    MENU_NAMED(MENU_SET_TOT,      gSetting_set_tot,             SETTINGS_RECORD_F4HWN, gSubMenu_SET_TOT, NULL),
+    MENU_NAMED(MENU_SET_EOT,      gSetting_set_eot,             SETTINGS_RECORD_F4HWN, gSubMenu_SET_TOT, NULL),
+    #ifdef ENABLE_FEAT_F4HWN_CTR
+        MENU_VALUE(MENU_SET_CTR,  gSetting_set_ctr,             SETTINGS_RECORD_F4HWN, 1, 15, NULL),
+    #endif
+    #ifdef ENABLE_FEAT_F4HWN_INV
+        MENU_NAMED(MENU_SET_INV,  gSetting_set_inv,             SETTINGS_RECORD_F4HWN, gSubMenu_OFF_ON, NULL),
+    #endif
+    MENU_NAMED(MENU_SET_LCK,      gSetting_set_lck,             SETTINGS_RECORD_F4HWN, gSubMenu_SET_LCK, NULL),
+    MENU_NAMED(MENU_SET_MET,      gSetting_set_met,             SETTINGS_RECORD_F4HWN, gSubMenu_SET_MET, NULL),
+    MENU_NAMED(MENU_SET_GUI,      gSetting_set_gui,             SETTINGS_RECORD_F4HWN, gSubMenu_SET_MET, NULL),
+    #ifdef ENABLE_FEAT_F4HWN_RX_TX_TIMER
+        MENU_NAMED(MENU_SET_TMR,  gSetting_set_tmr,             SETTINGS_RECORD_F4HWN, gSubMenu_OFF_ON, NULL),
+    #endif
+    #ifdef ENABLE_FEAT_F4HWN_NARROWER
+        MENU_NAMED(MENU_SET_NFM,  gSetting_set_nfm,             SETTINGS_RECORD_MAIN, gSubMenu_SET_NFM, MENU_AcceptNarrower),
+    #endif
+    #ifdef ENABLE_FEAT_F4HWN_VOL
+        MENU_VALUE(MENU_SET_VOL,  gEeprom.VOLUME_GAIN,          SETTINGS_RECORD_VOL, 0, 63, NULL),
+    #endif
+#endif
+    MENU_NAMED(MENU_BATTYP,       gEeprom.BATTERY_TYPE,         SETTINGS_RECORD_KEYS, gSubMenu_BATTYP, NULL),
+};
+
+const MENU_Setting_t *MENU_GetSetting(uint8_t menu_id)
+{
+    for (unsigned int i = 0; i < ARRAY_SIZE(MenuSettings); i++) {
+        if (MenuSettings[i].Id == menu_id)
+            return &MenuSettings[i];
+    }
+    return NULL;
+}
+
+static void *MENU_SettingValue(const MENU_Setting_t *pSetting)
+{
+    if (pSetting->Records != 0)
+        return pSetting->pValue;
+
+    // same field of the VFO being edited
+    return (uint8_t *)gTxVfo + ((uint8_t *)pSetting->pValue - (uint8_t *)&gEeprom.VfoInfo[0]);
+}
+
+static int32_t MENU_LoadSetting(const MENU_Setting_t *pSetting)
+{
+    const void *pValue = MENU_SettingValue(pSetting);
+
+    switch (pSetting->Size) {
+        case 1:  return *(const uint8_t *)pValue;
+        case 2:  return *(const uint16_t *)pValue;
+        default: return *(const uint32_t *)pValue;
+    }
+}
+
+static void MENU_StoreSetting(const MENU_Setting_t *pSetting, int32_t Value)
+{
+    void *pValue = MENU_SettingValue(pSetting);
+
+    switch (pSetting->Size) {
+        case 1:  *(uint8_t *)pValue  = Value; break;
+        case 2:  *(uint16_t *)pValue = Value; break;
+        default: *(uint32_t *)pValue = Value; break;
+    }
+}
+
 int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
 {
+    const MENU_Setting_t *pSetting = MENU_GetSetting(menu_id);
+
+    if (pSetting != NULL) {
+        *pMin = pSetting->Min;
+        *pMax = pSetting->Max;
+        return 0;
+    }
+
     *pMin = 0;
 
     switch (menu_id)
     {
-        case MENU_SQL:
-            
-            *pMax = 9;
-            break;
-
         case MENU_STEP:
             
             *pMax = STEP_N_ELEM - 1;
@@ -132,48 +342,11 @@ int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
             *pMax = ARRAY_SIZE(gSubMenu_F_LOCK) - 1;
             break;
 
-        case MENU_MDF:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_MDF) - 1;
-            break;
-
-        case MENU_TXP:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_TXP) - 1;
-            break;
-
-        case MENU_SFT_D:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_SFT_D) - 1;
-            break;
-
         case MENU_TDR:
             
             *pMax = ARRAY_SIZE(gSubMenu_RXMode) - 1;
             break;
 
-        #ifdef ENABLE_VOICE
-            case MENU_VOICE:
-                
-                *pMax = ARRAY_SIZE(gSubMenu_VOICE) - 1;
-                break;
-        #endif
-
-        case MENU_SC_REV:
-            
-            *pMax = 104;
-            break;
-
-        case MENU_ROGER:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_ROGER) - 1;
-            break;
-
-        case MENU_PONMSG:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_PONMSG) - 1;
-            break;
-
         case MENU_R_DCS:
         case MENU_T_DCS:
             
@@ -187,95 +360,31 @@ int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
             *pMax = ARRAY_SIZE(CTCSS_Options);
             break;
 
-        case MENU_W_N:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_W_N) - 1;
-            break;
-
-        #ifdef ENABLE_ALARM
-            case MENU_AL_MOD:
-                
-                *pMax = ARRAY_SIZE(gSubMenu_AL_MOD) - 1;
-                break;
-        #endif
-
         case MENU_RESET:
             
             *pMax = ARRAY_SIZE(gSubMenu_RESET) - 1;
             break;
 
         case MENU_COMPAND:
-        case MENU_ABR_ON_TX_RX:
             
             *pMax = ARRAY_SIZE(gSubMenu_RX_TX) - 1;
             break;
 
-        #ifndef ENABLE_FEAT_F4HWN
-
-        #endif
-        #ifdef ENABLE_AUDIO_BAR
-            case MENU_MIC_BAR:
-        #endif
-        case MENU_BCL:
-        case MENU_BEEP:
         case MENU_S_ADD1:
         case MENU_S_ADD2:
         case MENU_S_ADD3:
-        case MENU_STE:
-        case MENU_D_ST:
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_DCD:
-#endif
-        case MENU_D_LIVE_DEC:
-        #ifdef ENABLE_NOAA
-            case MENU_NOAA_S:
-        #endif
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_350TX:
-        case MENU_200TX:
-        case MENU_500TX:
-#endif
-        case MENU_350EN:
-        case MENU_SCREN:
-
-#ifdef ENABLE_FEAT_F4HWN
-        #ifdef ENABLE_FEAT_F4HWN_RX_TX_TIMER    
-        case MENU_SET_TMR:
-        #endif
-#endif
             
             *pMax = ARRAY_SIZE(gSubMenu_OFF_ON) - 1;
             break;
-        case MENU_AM:
-            
-            *pMax = ARRAY_SIZE(gModulationStr) - 1;
-            break;
-
-        case MENU_SCR:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_SCRAMBLER) - 1;
-            break;
-
-        case MENU_AUTOLK:
-            *pMax = 40;
-            break;
-
-        case MENU_TOT:
-            
-            *pMin = 5;
-            *pMax = 179;
-            break;
 
         #ifdef ENABLE_VOX
             case MENU_VOX:
+                
+                *pMax = 10;
+                break;
         #endif
-        case MENU_RP_STE:
-            
-            *pMax = 10;
-            break;
 
         case MENU_MEM_CH:
-        case MENU_1_CALL:
         case MENU_DEL_CH:
         case MENU_MEM_NAME:
             
@@ -289,43 +398,6 @@ int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
             *pMax = MR_CHANNEL_LAST;
             break;
 
-        case MENU_SAVE:
-            
-            *pMax = 5;
-            break;
-
-        case MENU_MIC:
-            
-            *pMax = 4;
-            break;
-
-        case MENU_S_LIST:
-            
-            *pMax = 5;
-            break;
-
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_RSP:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_D_RSP) - 1;
-            break;
-#endif
-        case MENU_PTT_ID:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_PTT_ID) - 1;
-            break;
-
-        case MENU_BAT_TXT:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_BAT_TXT) - 1;
-            break;
-
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_HOLD:
-            *pMin = 5;
-            *pMax = 60;
-            break;
-#endif
         case MENU_D_PRE:
             *pMin = 3;
             *pMax = 99;
@@ -349,10 +421,11 @@ int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
             *pMax = 3500;
             break;
 
-        case MENU_BATTYP:
-            
-            *pMax = 4;
+#ifdef ENABLE_PROFILER
+        case MENU_PROFILE:
+            *pMax = PROFILE_TASK_N - 1;
             break;
+#endif
 
         case MENU_F1SHRT:
         case MENU_F1LONG:
@@ -363,62 +436,6 @@ int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax)
             *pMax = gSubMenu_SIDEFUNCTIONS_size-1;
             break;
 
-#ifdef ENABLE_FEAT_F4HWN_SLEEP
-        case MENU_SET_OFF:
-            *pMax = 120;
-            break;
-#endif
-
-#ifdef ENABLE_FEAT_F4HWN
-        case MENU_SET_PWR:
-            *pMax = ARRAY_SIZE(gSubMenu_SET_PWR) - 1;
-            break;
-        // case MENU_SET_PTT:
-            
-        //     *pMax = ARRAY_SIZE(gSubMenu_SET_PTT) - 1;
-        //     break; // PTTDEL
-        case MENU_SET_TOT:
-        case MENU_SET_EOT:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_SET_TOT) - 1;
-            break;
-#ifdef ENABLE_FEAT_F4HWN_CTR
-        case MENU_SET_CTR:
-            *pMin = 1;
-            *pMax = 15;
-            break;
-#endif
-        case MENU_TX_LOCK:
-#ifdef ENABLE_FEAT_F4HWN_INV
-        case MENU_SET_INV:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_OFF_ON) - 1;
-            break;
-#endif
-        case MENU_SET_LCK:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_SET_LCK) - 1;
-            break;
-        case MENU_SET_MET:
-        case MENU_SET_GUI:
-            
-            *pMax = ARRAY_SIZE(gSubMenu_SET_MET) - 1;
-            break;
-        #ifdef ENABLE_FEAT_F4HWN_NARROWER
-            case MENU_SET_NFM:
-                
-                *pMax = ARRAY_SIZE(gSubMenu_SET_NFM) - 1;
-                break;
-        #endif
-        #ifdef ENABLE_FEAT_F4HWN_VOL
-            case MENU_SET_VOL:
-                
-                *pMax = 63;
-                break;
-        #endif
- 
-#endif
-
         default:
             return -1;
     }
@@ -431,6 +448,7 @@ void MENU_AcceptSetting(void)
     int32_t        Min;
     int32_t        Max;
     FREQ_Config_t *pConfig = &gTxVfo->freq_config_RX;
+    uint8_t        Records = SETTINGS_RECORD_MAIN;
 
     if (!MENU_GetLimits(UI_MENU_GetCurrentMenuId(), &Min, &Max))
     {
@@ -439,16 +457,24 @@ void MENU_AcceptSetting(void)
         if (gSubMenuSelection > Max) gSubMenuSelection = Max;
     }
 
+    const MENU_Setting_t *pSetting = MENU_GetSetting(UI_MENU_GetCurrentMenuId());
+    if (pSetting != NULL) {
+        MENU_StoreSetting(pSetting, gSubMenuSelection);
+        if (pSetting->pAccept != NULL)
+            pSetting->pAccept();
+
+        if (pSetting->Records != 0)
+            gRequestSaveRecords |= pSetting->Records;
+        else
+            gRequestSaveChannel = 1;
+        return;
+    }
+
     switch (UI_MENU_GetCurrentMenuId())
     {
         default:
             return;
 
-        case MENU_SQL:
-            gEeprom.SQUELCH_LEVEL = gSubMenuSelection;
-            gVfoConfigureMode     = VFO_CONFIGURE;
-            break;
-
         case MENU_STEP:
             gTxVfo->STEP_SETTING = FREQUENCY_GetStepIdxFromSortedIdx(gSubMenuSelection);
             if (IS_FREQ_CHANNEL(gTxVfo->CHANNEL_SAVE))
@@ -457,11 +483,6 @@ void MENU_AcceptSetting(void)
             }
             return;
 
-        case MENU_TXP:
-            gTxVfo->OUTPUT_POWER = gSubMenuSelection;
-            gRequestSaveChannel = 1;
-            return;
-
         case MENU_T_DCS:
             pConfig = &gTxVfo->freq_config_TX;
 
@@ -506,39 +527,11 @@ void MENU_AcceptSetting(void)
             gRequestSaveChannel = 1;
             return;
         }
-        case MENU_SFT_D:
-            gTxVfo->TX_OFFSET_FREQUENCY_DIRECTION = gSubMenuSelection;
-            gRequestSaveChannel                   = 1;
-            return;
-
         case MENU_OFFSET:
             gTxVfo->TX_OFFSET_FREQUENCY = gSubMenuSelection;
             gRequestSaveChannel         = 1;
             return;
 
-        case MENU_W_N:
-            gTxVfo->CHANNEL_BANDWIDTH = gSubMenuSelection;
-            gRequestSaveChannel       = 1;
-            return;
-
-        case MENU_SCR:
-            gTxVfo->SCRAMBLING_TYPE = gSubMenuSelection;
-                if (gSubMenuSelection > 0 && gSetting_ScrambleEnable)
-                    BK4819_EnableScramble(gSubMenuSelection - 1);
-                else
-                    BK4819_DisableScramble();
-                                       
-                
-                
-
-            gRequestSaveChannel     = 1;
-            return;
-
-        case MENU_BCL:
-            gTxVfo->BUSY_CHANNEL_LOCK = gSubMenuSelection;
-            gRequestSaveChannel       = 1;
-            return;
-
         case MENU_MEM_CH:
             gTxVfo->CHANNEL_SAVE = gSubMenuSelection;
             #if 0
@@ -561,10 +554,6 @@ void MENU_AcceptSetting(void)
             SETTINGS_SaveChannelName(gSubMenuSelection, edit);
             return;
 
-        case MENU_SAVE:
-            gEeprom.BATTERY_SAVE = gSubMenuSelection;
-            break;
-
         #ifdef ENABLE_VOX
             case MENU_VOX:
                 gEeprom.VOX_SWITCH = gSubMenuSelection != 0;
@@ -593,10 +582,6 @@ void MENU_AcceptSetting(void)
             gEeprom.BACKLIGHT_MIN = MIN(gSubMenuSelection - 1, gEeprom.BACKLIGHT_MIN);
             break;
 
-        case MENU_ABR_ON_TX_RX:
-            gSetting_backlight_on_tx_rx = gSubMenuSelection;
-            break;
-
         case MENU_TDR:
             gEeprom.DUAL_WATCH = (gEeprom.TX_VFO + 1) * (gSubMenuSelection & 1);
             gEeprom.CROSS_BAND_RX_TX = (gEeprom.TX_VFO + 1) * ((gSubMenuSelection & 2) > 0);
@@ -611,34 +596,6 @@ void MENU_AcceptSetting(void)
             gUpdateStatus        = true;
             break;
 
-        case MENU_BEEP:
-            gEeprom.BEEP_CONTROL = gSubMenuSelection;
-            break;
-
-        case MENU_TOT:
-            gEeprom.TX_TIMEOUT_TIMER = gSubMenuSelection;
-            break;
-
-        #ifdef ENABLE_VOICE
-            case MENU_VOICE:
-                gEeprom.VOICE_PROMPT = gSubMenuSelection;
-                gUpdateStatus        = true;
-                break;
-        #endif
-
-        case MENU_SC_REV:
-            gEeprom.SCAN_RESUME_MODE = gSubMenuSelection;
-            break;
-
-        case MENU_MDF:
-            gEeprom.CHANNEL_DISPLAY_MODE = gSubMenuSelection;
-            break;
-
-        case MENU_AUTOLK:
-            gEeprom.AUTO_KEYPAD_LOCK = gSubMenuSelection;
-            gKeyLockCountdown        = gEeprom.AUTO_KEYPAD_LOCK * 30; 
-            break;
-
         case MENU_S_ADD1:
             gTxVfo->SCANLIST1_PARTICIPATION = gSubMenuSelection;
             SETTINGS_UpdateChannel(gTxVfo->CHANNEL_SAVE, gTxVfo, true, false, true);
@@ -660,26 +617,6 @@ void MENU_AcceptSetting(void)
             gFlagResetVfos    = true;
             return;
 
-        case MENU_STE:
-            gEeprom.TAIL_TONE_ELIMINATION = gSubMenuSelection;
-            break;
-
-        case MENU_RP_STE:
-            gEeprom.REPEATER_TAIL_TONE_ELIMINATION = gSubMenuSelection;
-            break;
-
-        case MENU_MIC:
-            gEeprom.MIC_SENSITIVITY = gSubMenuSelection;
-            SETTINGS_LoadCalibration();
-            gFlagReconfigureVfos = true;
-            break;
-
-        #ifdef ENABLE_AUDIO_BAR
-            case MENU_MIC_BAR:
-                gSetting_mic_bar = gSubMenuSelection;
-                break;
-        #endif
-
         case MENU_COMPAND:
             gTxVfo->Compander = gSubMenuSelection;
             SETTINGS_UpdateChannel(gTxVfo->CHANNEL_SAVE, gTxVfo, true, false, true);
@@ -688,62 +625,9 @@ void MENU_AcceptSetting(void)
 
             return;
 
-        case MENU_1_CALL:
-            gEeprom.CHAN_1_CALL = gSubMenuSelection;
-            break;
-
-        case MENU_S_LIST:
-            gEeprom.SCAN_LIST_DEFAULT = gSubMenuSelection;
-            break;
-
-        #ifdef ENABLE_ALARM
-            case MENU_AL_MOD:
-                gEeprom.ALARM_MODE = gSubMenuSelection;
-                break;
-        #endif
-
-        case MENU_D_ST:
-            gEeprom.DTMF_SIDE_TONE = gSubMenuSelection;
-            break;
-
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_RSP:
-            gEeprom.DTMF_DECODE_RESPONSE = gSubMenuSelection;
-            break;
-
-        case MENU_D_HOLD:
-            gEeprom.DTMF_auto_reset_time = gSubMenuSelection;
-            break;
-#endif
         case MENU_D_PRE:
             gEeprom.DTMF_PRELOAD_TIME = gSubMenuSelection * 10;
-            break;
-
-        case MENU_PTT_ID:
-            gTxVfo->DTMF_PTT_ID_TX_MODE = gSubMenuSelection;
-            gRequestSaveChannel         = 1;
-            return;
-
-        case MENU_BAT_TXT:
-            gSetting_battery_text = gSubMenuSelection;
-            break;
-
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_DCD:
-            gTxVfo->DTMF_DECODING_ENABLE = gSubMenuSelection;
-            DTMF_clear_RX();
-            gRequestSaveChannel = 1;
-            return;
-#endif
-
-        case MENU_D_LIVE_DEC:
-            gSetting_live_DTMF_decoder = gSubMenuSelection;
-            gDTMF_RX_live_timeout = 0;
-            memset(gDTMF_RX_live, 0, sizeof(gDTMF_RX_live));
-            if (!gSetting_live_DTMF_decoder)
-                BK4819_DisableDTMF();
-            gFlagReconfigureVfos     = true;
-            gUpdateStatus            = true;
+            Records = SETTINGS_RECORD_KEYS;
             break;
 
 #ifdef ENABLE_DTMF_CALLING
@@ -759,26 +643,6 @@ void MENU_AcceptSetting(void)
             }
             return;
 #endif
-        case MENU_PONMSG:
-            gEeprom.POWER_ON_DISPLAY_MODE = gSubMenuSelection;
-            break;
-
-        case MENU_ROGER:
-            gEeprom.ROGER = gSubMenuSelection;
-            break;
-
-        case MENU_AM:
-            gTxVfo->Modulation     = gSubMenuSelection;
-            gRequestSaveChannel = 1;
-            return;
-
-        #ifdef ENABLE_NOAA
-            case MENU_NOAA_S:
-                gEeprom.NOAA_AUTO_SCAN = gSubMenuSelection;
-                gFlagReconfigureVfos   = true;
-                break;
-        #endif
-
         case MENU_DEL_CH:
             SETTINGS_UpdateChannel(gSubMenuSelection, NULL, false, false, true);
             gVfoConfigureMode = VFO_CONFIGURE_RELOAD;
@@ -789,12 +653,6 @@ void MENU_AcceptSetting(void)
             SETTINGS_FactoryReset(gSubMenuSelection);
             return;
 
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_350TX:
-            gSetting_350TX = gSubMenuSelection;
-            break;
-#endif
-
         case MENU_F_LOCK: {
             if(gSubMenuSelection == F_LOCK_NONE) { 
                 gUnlockAllTxConfCnt++;
@@ -809,6 +667,7 @@ void MENU_AcceptSetting(void)
                 gUnlockAllTxConfCnt = 0;
 
             gSetting_F_LOCK = gSubMenuSelection;
+            Records         = SETTINGS_RECORD_FLAGS;
 
             #ifdef ENABLE_FEAT_F4HWN
             if(gSetting_F_LOCK == F_LOCK_ALL) {
@@ -817,26 +676,6 @@ void MENU_AcceptSetting(void)
             #endif
             break;
         }
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_200TX:
-            gSetting_200TX = gSubMenuSelection;
-            break;
-
-        case MENU_500TX:
-            gSetting_500TX = gSubMenuSelection;
-            break;
-#endif
-        case MENU_350EN:
-            gSetting_350EN       = gSubMenuSelection;
-            gVfoConfigureMode    = VFO_CONFIGURE_RELOAD;
-            gFlagResetVfos       = true;
-            break;
-
-        case MENU_SCREN:
-            gSetting_ScrambleEnable = gSubMenuSelection;
-            gFlagReconfigureVfos    = true;
-            break;
-
         #ifdef ENABLE_F_CAL_MENU
             case MENU_F_CALI:
                 writeXtalFreqCal(gSubMenuSelection, true);
@@ -855,9 +694,11 @@ void MENU_AcceptSetting(void)
             return;
         }
 
-        case MENU_BATTYP:
-            gEeprom.BATTERY_TYPE = gSubMenuSelection;
-            break;
+#ifdef ENABLE_PROFILER
+        case MENU_PROFILE:
+            PROFILE_Reset();
+            return;
+#endif
 
         case MENU_F1SHRT:
         case MENU_F1LONG:
@@ -873,72 +714,11 @@ void MENU_AcceptSetting(void)
                     &gEeprom.KEY_M_LONG_PRESS_ACTION};
                 *fun[UI_MENU_GetCurrentMenuId()-MENU_F1SHRT] = gSubMenu_SIDEFUNCTIONS[gSubMenuSelection].id;
             }
+            Records = SETTINGS_RECORD_KEYS;
             break;
-
-#ifdef ENABLE_FEAT_F4HWN_SLEEP 
-        case MENU_SET_OFF:
-            gSetting_set_off = gSubMenuSelection;
-            break;
-#endif
-
-#ifdef ENABLE_FEAT_F4HWN
-        case MENU_SET_PWR:
-            gSetting_set_pwr = gSubMenuSelection;
-            gRequestSaveChannel = 1;
-            break;
-        // case MENU_SET_PTT:
-        //     gSetting_set_ptt = gSubMenuSelection;
-        //     gSetting_set_ptt_session = gSetting_set_ptt; 
-        //     break;/ PTTDEL
-        case MENU_SET_TOT:
-            gSetting_set_tot = gSubMenuSelection;
-            break;
-        case MENU_SET_EOT:
-            gSetting_set_eot = gSubMenuSelection;
-            break;
-#ifdef ENABLE_FEAT_F4HWN_CTR
-        case MENU_SET_CTR:
-            gSetting_set_ctr = gSubMenuSelection;
-            break;
-#endif
-        case MENU_SET_INV:
-            gSetting_set_inv = gSubMenuSelection;
-            break;
-        case MENU_SET_LCK:
-            gSetting_set_lck = gSubMenuSelection;
-            break;
-        case MENU_SET_MET:
-            gSetting_set_met = gSubMenuSelection;
-            break;
-        case MENU_SET_GUI:
-            gSetting_set_gui = gSubMenuSelection;
-            break;
-        #ifdef ENABLE_FEAT_F4HWN_NARROWER
-            case MENU_SET_NFM:
-                gSetting_set_nfm = gSubMenuSelection;
-                RADIO_SetTxParameters();
-                RADIO_SetupRegisters(true);
-                break;
-        #endif
-        #ifdef ENABLE_FEAT_F4HWN_VOL
-            case MENU_SET_VOL:
-                gEeprom.VOLUME_GAIN = gSubMenuSelection;
-                break;
-        #endif
-
-        #ifdef ENABLE_FEAT_F4HWN_RX_TX_TIMER    
-        case MENU_SET_TMR:
-            gSetting_set_tmr = gSubMenuSelection;
-            break;
-        #endif    
-        case MENU_TX_LOCK:
-            gTxVfo->TX_LOCK = gSubMenuSelection;
-            gRequestSaveChannel       = 1;
-            return;
-#endif
     }
 
-    gRequestSaveSettings = true;
+    gRequestSaveRecords |= Records;
 }
 
 static void MENU_ClampSelection(int8_t Direction)
@@ -958,20 +738,19 @@ static void MENU_ClampSelection(int8_t Direction)
 
 void MENU_ShowCurrentSetting(void)
 {
+    const MENU_Setting_t *pSetting = MENU_GetSetting(UI_MENU_GetCurrentMenuId());
+
+    if (pSetting != NULL) {
+        gSubMenuSelection = MENU_LoadSetting(pSetting);
+        return;
+    }
+
     switch (UI_MENU_GetCurrentMenuId())
     {
-        case MENU_SQL:
-            gSubMenuSelection = gEeprom.SQUELCH_LEVEL;
-            break;
-
         case MENU_STEP:
             gSubMenuSelection = FREQUENCY_GetSortedIdxFromStepIdx(gTxVfo->STEP_SETTING);
             break;
 
-        case MENU_TXP:
-            gSubMenuSelection = gTxVfo->OUTPUT_POWER;
-            break;
-
         case MENU_RESET:
             gSubMenuSelection = 0;
             break;
@@ -1027,26 +806,10 @@ void MENU_ShowCurrentSetting(void)
             gSubMenuSelection = (gTxVfo->freq_config_TX.CodeType == CODE_TYPE_CONTINUOUS_TONE) ? gTxVfo->freq_config_TX.Code + 1 : 0;
             break;
 
-        case MENU_SFT_D:
-            gSubMenuSelection = gTxVfo->TX_OFFSET_FREQUENCY_DIRECTION;
-            break;
-
         case MENU_OFFSET:
             gSubMenuSelection = gTxVfo->TX_OFFSET_FREQUENCY;
             break;
 
-        case MENU_W_N:
-            gSubMenuSelection = gTxVfo->CHANNEL_BANDWIDTH;
-            break;
-
-        case MENU_SCR:
-            gSubMenuSelection = gTxVfo->SCRAMBLING_TYPE;
-            break;
-
-        case MENU_BCL:
-            gSubMenuSelection = gTxVfo->BUSY_CHANNEL_LOCK;
-            break;
-
         case MENU_MEM_CH:
             #if 0
                 gSubMenuSelection = gEeprom.MrChannel[0];
@@ -1059,10 +822,6 @@ void MENU_ShowCurrentSetting(void)
             gSubMenuSelection = gEeprom.MrChannel[gEeprom.TX_VFO];
             break;
 
-        case MENU_SAVE:
-            gSubMenuSelection = gEeprom.BATTERY_SAVE;
-            break;
-
 #ifdef ENABLE_VOX
         case MENU_VOX:
             gSubMenuSelection = gEeprom.VOX_SWITCH ? gEeprom.VOX_LEVEL + 1 : 0;
@@ -1092,40 +851,10 @@ void MENU_ShowCurrentSetting(void)
             gSubMenuSelection = gEeprom.BACKLIGHT_MAX;
             break;
 
-        case MENU_ABR_ON_TX_RX:
-            gSubMenuSelection = gSetting_backlight_on_tx_rx;
-            break;
-
         case MENU_TDR:
             gSubMenuSelection = (gEeprom.DUAL_WATCH != DUAL_WATCH_OFF) + (gEeprom.CROSS_BAND_RX_TX != CROSS_BAND_OFF) * 2;
             break;
 
-        case MENU_BEEP:
-            gSubMenuSelection = gEeprom.BEEP_CONTROL;
-            break;
-
-        case MENU_TOT:
-            gSubMenuSelection = gEeprom.TX_TIMEOUT_TIMER;
-            break;
-
-#ifdef ENABLE_VOICE
-        case MENU_VOICE:
-            gSubMenuSelection = gEeprom.VOICE_PROMPT;
-            break;
-#endif
-
-        case MENU_SC_REV:
-            gSubMenuSelection = gEeprom.SCAN_RESUME_MODE;
-            break;
-
-        case MENU_MDF:
-            gSubMenuSelection = gEeprom.CHANNEL_DISPLAY_MODE;
-            break;
-
-        case MENU_AUTOLK:
-            gSubMenuSelection = gEeprom.AUTO_KEYPAD_LOCK;
-            break;
-
         case MENU_S_ADD1:
             gSubMenuSelection = gTxVfo->SCANLIST1_PARTICIPATION;
             break;
@@ -1138,103 +867,25 @@ void MENU_ShowCurrentSetting(void)
             gSubMenuSelection = gTxVfo->SCANLIST3_PARTICIPATION;
             break;
 
-        case MENU_STE:
-            gSubMenuSelection = gEeprom.TAIL_TONE_ELIMINATION;
-            break;
-
-        case MENU_RP_STE:
-            gSubMenuSelection = gEeprom.REPEATER_TAIL_TONE_ELIMINATION;
-            break;
-
-        case MENU_MIC:
-            gSubMenuSelection = gEeprom.MIC_SENSITIVITY;
-            break;
-
-#ifdef ENABLE_AUDIO_BAR
-        case MENU_MIC_BAR:
-            gSubMenuSelection = gSetting_mic_bar;
-            break;
-#endif
-
         case MENU_COMPAND:
             gSubMenuSelection = gTxVfo->Compander;
             return;
 
-        case MENU_1_CALL:
-            gSubMenuSelection = gEeprom.CHAN_1_CALL;
-            break;
-
-        case MENU_S_LIST:
-            gSubMenuSelection = gEeprom.SCAN_LIST_DEFAULT;
-            break;
-
         case MENU_SLIST1:
         case MENU_SLIST2:
         case MENU_SLIST3:
             gSubMenuSelection = RADIO_FindNextChannel(0, 1, true, UI_MENU_GetCurrentMenuId() - MENU_SLIST1 + 1);
             break;
 
-        #ifdef ENABLE_ALARM
-            case MENU_AL_MOD:
-                gSubMenuSelection = gEeprom.ALARM_MODE;
-                break;
-        #endif
-
-        case MENU_D_ST:
-            gSubMenuSelection = gEeprom.DTMF_SIDE_TONE;
-            break;
-
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_RSP:
-            gSubMenuSelection = gEeprom.DTMF_DECODE_RESPONSE;
-            break;
-
-        case MENU_D_HOLD:
-            gSubMenuSelection = gEeprom.DTMF_auto_reset_time;
-            break;
-#endif
         case MENU_D_PRE:
             gSubMenuSelection = gEeprom.DTMF_PRELOAD_TIME / 10;
             break;
 
-        case MENU_PTT_ID:
-            gSubMenuSelection = gTxVfo->DTMF_PTT_ID_TX_MODE;
-            break;
-
-        case MENU_BAT_TXT:
-            gSubMenuSelection = gSetting_battery_text;
-            return;
-
 #ifdef ENABLE_DTMF_CALLING
-        case MENU_D_DCD:
-            gSubMenuSelection = gTxVfo->DTMF_DECODING_ENABLE;
-            break;
-
         case MENU_D_LIST:
             gSubMenuSelection = gDTMF_chosen_contact + 1;
             break;
 #endif
-        case MENU_D_LIVE_DEC:
-            gSubMenuSelection = gSetting_live_DTMF_decoder;
-            break;
-
-        case MENU_PONMSG:
-            gSubMenuSelection = gEeprom.POWER_ON_DISPLAY_MODE;
-            break;
-
-        case MENU_ROGER:
-            gSubMenuSelection = gEeprom.ROGER;
-            break;
-
-        case MENU_AM:
-            gSubMenuSelection = gTxVfo->Modulation;
-            break;
-
-        #ifdef ENABLE_NOAA
-            case MENU_NOAA_S:
-                gSubMenuSelection = gEeprom.NOAA_AUTO_SCAN;
-                break;
-        #endif
 
         case MENU_DEL_CH:
             #if 0
@@ -1244,34 +895,10 @@ void MENU_ShowCurrentSetting(void)
             #endif
             break;
 
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_350TX:
-            gSubMenuSelection = gSetting_350TX;
-            break;
-#endif
-
         case MENU_F_LOCK:
             gSubMenuSelection = gSetting_F_LOCK;
             break;
 
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_200TX:
-            gSubMenuSelection = gSetting_200TX;
-            break;
-
-        case MENU_500TX:
-            gSubMenuSelection = gSetting_500TX;
-            break;
-
-#endif
-        case MENU_350EN:
-            gSubMenuSelection = gSetting_350EN;
-            break;
-
-        case MENU_SCREN:
-            gSubMenuSelection = gSetting_ScrambleEnable;
-            break;
-
         #ifdef ENABLE_F_CAL_MENU
             case MENU_F_CALI:
                 gSubMenuSelection = gEeprom.BK4819_XTAL_FREQ_LOW;
@@ -1282,9 +909,11 @@ void MENU_ShowCurrentSetting(void)
             gSubMenuSelection = gBatteryCalibration[3];
             break;
 
-        case MENU_BATTYP:
-            gSubMenuSelection = gEeprom.BATTERY_TYPE;
+#ifdef ENABLE_PROFILER
+        case MENU_PROFILE:
+            gSubMenuSelection = PROFILE_DISPLAY;
             break;
+#endif
 
         case MENU_F1SHRT:
         case MENU_F1LONG:
@@ -1310,63 +939,6 @@ void MENU_ShowCurrentSetting(void)
             break;
         }
 
-#ifdef ENABLE_FEAT_F4HWN_SLEEP 
-        case MENU_SET_OFF:
-            gSubMenuSelection = gSetting_set_off;
-            break;
-#endif
-
-#ifdef ENABLE_FEAT_F4HWN
-        case MENU_SET_PWR:
-            gSubMenuSelection = gSetting_set_pwr;
-            break;
-        // case MENU_SET_PTT:
-        //     gSubMenuSelection = gSetting_set_ptt_session;
-        //     break;/ PTTDEL
-        case MENU_SET_TOT:
-            gSubMenuSelection = gSetting_set_tot;
-            break;
-        case MENU_SET_EOT:
-            gSubMenuSelection = gSetting_set_eot;
-            break;
-#ifdef ENABLE_FEAT_F4HWN_CTR
-        case MENU_SET_CTR:
-            gSubMenuSelection = gSetting_set_ctr;
-            break;
-#endif
-        case MENU_SET_INV:
-            gSubMenuSelection = gSetting_set_inv;
-            break;
-        case MENU_SET_LCK:
-            gSubMenuSelection = gSetting_set_lck;
-            break;
-        case MENU_SET_MET:
-            gSubMenuSelection = gSetting_set_met;
-            break;
-        case MENU_SET_GUI:
-            gSubMenuSelection = gSetting_set_gui;
-            break;
-        #ifdef ENABLE_FEAT_F4HWN_NARROWER
-            case MENU_SET_NFM:
-                gSubMenuSelection = gSetting_set_nfm;
-                break;
-        #endif
-        #ifdef ENABLE_FEAT_F4HWN_VOL
-            case MENU_SET_VOL:
-                gSubMenuSelection = gEeprom.VOLUME_GAIN;
-                break;
-        #endif
-
-        #ifdef ENABLE_FEAT_F4HWN_RX_TX_TIMER    
-        case MENU_SET_TMR:
-            gSubMenuSelection = gSetting_set_tmr;
-            break;
-        #endif
-        case MENU_TX_LOCK:
-            gSubMenuSelection = gTxVfo->TX_LOCK;
-            break;
-#endif
-
         default:
             return;
     }
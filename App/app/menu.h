@@ -2,6 +2,8 @@
 #ifndef APP_MENU_H
 #define APP_MENU_H
 
+#include <stdint.h>
+
 #include "driver/keyboard.h"
 
 #ifdef ENABLE_F_CAL_MENU
@@ -10,6 +12,21 @@
 
 extern uint8_t gUnlockAllTxConfCnt;
 
+// a menu item whose value lives in a plain variable, handled by the generic
+// limit, display and save paths instead of a case in every menu switch
+typedef struct {
+    void        *pValue;            // per channel values point into gEeprom.VfoInfo[0] and are used on gTxVfo
+    const char  *pNames;            // NameSize wide value names, NULL if UI_DisplayMenu draws the value
+    void       (*pAccept)(void);    // side effects once the value is stored
+    uint8_t      Id;
+    uint8_t      Size;
+    uint8_t      Records;           // SETTINGS_RECORD_* holding the value, 0 for per channel values
+    uint8_t      NameSize;
+    int8_t       Min;
+    uint8_t      Max;
+} MENU_Setting_t;
+
+const MENU_Setting_t *MENU_GetSetting(uint8_t menu_id);
 int MENU_GetLimits(uint8_t menu_id, int32_t *pMin, int32_t *pMax);
 void MENU_AcceptSetting(void);
 void MENU_ShowCurrentSetting(void);
@@ -23,6 +23,12 @@
 #ifdef ENABLE_FMRADIO
     #include "app/fm.h"
 #endif
+#ifdef ENABLE_AM_FIX__
+    #include "am_fix.h"
+#endif
+#if defined(ENABLE_DTMF_CALLING) || defined(ENABLE_DTMF_LOG)
+    #include "app/dtmf.h"
+#endif
 #include "app/uart.h"
 #include "board.h"
 #include "py32f071_ll_dma.h"
@@ -31,6 +37,17 @@
 #include "driver/crc.h"
 #include "driver/eeprom.h"
 #include "driver/gpio.h"
+#include "driver/py25q16.h"
+#ifdef ENABLE_PROFILER
+    #include "app/app.h"
+    #include "driver/st7565.h"
+    #include "helper/profile.h"
+    #include "ui/ui.h"
+    #include "helper/powersave.h"
+    #ifdef ENABLE_PRIORITY_WATCH
+        #include "app/watch.h"
+    #endif
+#endif
 
 #if defined(ENABLE_UART)
 #include "driver/uart.h"
@@ -159,6 +176,136 @@ typedef struct {
 } CMD_052F_t;
 #endif
 
+#ifdef ENABLE_PROFILER
+typedef struct {
+    Header_t Header;
+    bool     bReset;
+    uint8_t  Padding[3];
+} CMD_0535_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        struct {
+            uint16_t Min;
+            uint16_t Avg;
+            uint16_t Max;
+            uint16_t Overruns;
+        } Task[PROFILE_TASK_N];
+        uint16_t MissedSlices;
+        uint16_t FullRedraws;       // per second
+        uint16_t PartialRedraws;
+        uint16_t PagesSent;
+        uint16_t PagesSkipped;
+        uint8_t  Padding[2];
+        uint32_t RadioTransactions;
+        uint16_t FlashWritesElided;
+        uint16_t FlashWritesCommitted;
+        uint16_t FlashSectorErases;
+        uint8_t  Padding2[2];
+    } Data;
+} REPLY_0535_t;
+
+typedef struct {
+    Header_t Header;
+    uint8_t  Key;           // 0xFF only queries the last step
+    uint8_t  Hold_10ms;
+    uint8_t  Gap_10ms;
+    uint8_t  Padding;
+} CMD_0539_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        bool     bAccepted;
+        uint8_t  Pending;
+        uint8_t  Seq;
+        uint8_t  Key;
+        uint32_t Tick;
+        uint32_t PressLatency;      // us
+        uint32_t ReleaseLatency;
+    } Data;
+} REPLY_0539_t;
+
+typedef struct {
+    Header_t Header;
+    uint8_t  Page;          // 0 is the status line
+    uint8_t  Padding[3];
+} CMD_053B_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint8_t  Page;
+        uint8_t  Padding;
+        uint16_t FrameCrc;
+        uint16_t StatusCrc;
+        uint8_t  Padding2[2];
+        uint8_t  Data[LCD_WIDTH];
+    } Data;
+} REPLY_053B_t;
+
+typedef struct {
+    Header_t Header;
+    bool     bReset;
+    uint8_t  Padding[3];
+} CMD_053D_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        struct {
+            uint16_t Visits;
+            uint16_t Hits;
+            uint16_t MaxRevisit;
+        } Watch[4];         // VFO A, VFO B, priority 1, priority 2
+        uint16_t SleepCycles;
+        uint16_t QuietWakes;
+        uint16_t ActiveWakes;
+        uint16_t MissedRisk;
+        uint32_t Sleep_10ms;
+    } Data;
+} REPLY_053D_t;
+#endif
+
+#ifdef ENABLE_DTMF_LOG
+#define DTMF_LOG_REPLY_RECORDS 4
+
+typedef struct {
+    Header_t Header;
+    uint16_t Index;         // records back from the newest one
+    uint8_t  Padding[2];
+} CMD_053F_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint16_t         NextSeq;
+        uint16_t         EventsDropped;
+        uint8_t          Count;
+        uint8_t          Padding[3];
+        DTMF_LogRecord_t Record[DTMF_LOG_REPLY_RECORDS];    // newest first
+    } Data;
+} REPLY_053F_t;
+#endif
+
+#ifdef ENABLE_AM_FIX__
+typedef struct {
+    Header_t Header;
+    bool     bClear;
+    uint8_t  Padding[3];
+} CMD_0537_t;
+
+typedef struct {
+    Header_t Header;
+    struct {
+        uint8_t         Count;
+        uint8_t         Padding[3];
+        AM_fix_sample_t Sample[AM_FIX_TRACE_SIZE];  // oldest first
+    } Data;
+} REPLY_0537_t;
+#endif
+
 static const uint8_t Obfuscation[16] =
 {
     0x16, 0x6C, 0x14, 0xE6, 0x2E, 0x91, 0x0D, 0x40, 0x21, 0x35, 0xD5, 0x40, 0x13, 0x03, 0xE9, 0x80
@@ -411,7 +558,14 @@ static void CMD_051D(uint32_t Port, const uint8_t *pBuffer)
     const CMD_051D_t *pCmd = (const CMD_051D_t *)pBuffer;
     REPLY_051D_t Reply;
     bool bReloadEeprom;
+    bool bReloadAttributes = false;
     bool bIsLocked;
+#ifdef ENABLE_DTMF_CALLING
+    bool bReloadContacts = false;
+#endif
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+    bool bReloadNames = false;
+#endif
 
     uint32_t Timestamp = 0;
 
@@ -453,6 +607,7 @@ static void CMD_051D(uint32_t Port, const uint8_t *pBuffer)
     if (!bIsLocked)
     {
         unsigned int i;
+        PY25Q16_BeginUpdate();
         for (i = 0; i < (pCmd->Size / 8); i++)
         {
             const uint16_t Offset = pCmd->Offset + (i * 8U);
@@ -461,14 +616,39 @@ static void CMD_051D(uint32_t Port, const uint8_t *pBuffer)
                 if (!gIsLocked)
                     bReloadEeprom = true;
 
+            if (Offset >= 0x0D60 && Offset < 0x0E30)
+                bReloadAttributes = true;
+
+#ifdef ENABLE_DTMF_CALLING
+            if (Offset >= 0x1C00 && Offset < 0x1C00 + MAX_DTMF_CONTACTS * 16)
+                bReloadContacts = true;
+#endif
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+            if (Offset >= 0x0F50 && Offset < 0x1BD0)
+                bReloadNames = true;
+#endif
+
             if ((Offset < 0x0E98 || Offset >= 0x0EA0) || !bIsInLockScreen || pCmd->bAllowPassword)
             {    
                 EEPROM_WriteBuffer(Offset, &pCmd->Data[i * 8U]);
             }
         }
+        PY25Q16_CommitUpdate();
 
         if (bReloadEeprom)
             SETTINGS_InitEEPROM();
+        else if (bReloadAttributes)
+            SETTINGS_LoadChannelAttributes();
+
+#ifdef ENABLE_DTMF_CALLING
+        if (bReloadContacts)
+            DTMF_BuildContactIndex();
+#endif
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+        // the index only holds channels whose attributes make them valid
+        if (bReloadNames || bReloadAttributes || bReloadEeprom)
+            SETTINGS_BuildChannelNameIndex();
+#endif
     }
 
     SendReply(Port, &Reply, sizeof(Reply));
@@ -598,6 +778,167 @@ static void CMD_052F(uint32_t Port, const uint8_t *pBuffer)
 }
 #endif
 
+#ifdef ENABLE_PROFILER
+static void CMD_0535(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0535_t *pCmd = (const CMD_0535_t *)pBuffer;
+    REPLY_0535_t      Reply;
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0536;
+    Reply.Header.Size = sizeof(Reply.Data);
+
+    for (unsigned int i = 0; i < PROFILE_TASK_N; i++) {
+        Reply.Data.Task[i].Min      = gProfile.task[i].min_us;
+        Reply.Data.Task[i].Avg      = PROFILE_GetAverage_us(i);
+        Reply.Data.Task[i].Max      = gProfile.task[i].max_us;
+        Reply.Data.Task[i].Overruns = gProfile.task[i].overruns;
+    }
+
+    Reply.Data.MissedSlices   = gProfile.missedSlices;
+    Reply.Data.FullRedraws    = gRedrawStats.fullPerSecond;
+    Reply.Data.PartialRedraws = gRedrawStats.partialPerSecond;
+    Reply.Data.RadioTransactions = gBK4819_Transactions;
+    Reply.Data.FlashWritesElided    = gPY25Q16_WritesElided;
+    Reply.Data.FlashWritesCommitted = gPY25Q16_WritesCommitted;
+    Reply.Data.FlashSectorErases    = gPY25Q16_SectorErases;
+#ifdef ENABLE_FEAT_F4HWN
+    Reply.Data.PagesSent      = gST7565_PagesSent;
+    Reply.Data.PagesSkipped   = gST7565_PagesSkipped;
+#endif
+
+    if (pCmd->bReset) {
+        PROFILE_Reset();
+        memset(&gRedrawStats, 0, sizeof(gRedrawStats));
+        gPY25Q16_WritesElided    = 0;
+        gPY25Q16_WritesCommitted = 0;
+        gPY25Q16_SectorErases    = 0;
+    }
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+
+static void CMD_0539(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0539_t *pCmd = (const CMD_0539_t *)pBuffer;
+    REPLY_0539_t      Reply;
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x053A;
+    Reply.Header.Size = sizeof(Reply.Data);
+
+    if (pCmd->Key != 0xFF)
+        Reply.Data.bAccepted = APP_InjectKey(pCmd->Key, pCmd->Hold_10ms, pCmd->Gap_10ms);
+
+    Reply.Data.Pending        = APP_InjectPending();
+    Reply.Data.Seq            = gProfile.key.seq;
+    Reply.Data.Key            = gProfile.key.key;
+    Reply.Data.Tick           = gProfile.key.tick;
+    Reply.Data.PressLatency   = gProfile.key.press_us;
+    Reply.Data.ReleaseLatency = gProfile.key.release_us;
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+
+static void CMD_053B(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_053B_t *pCmd = (const CMD_053B_t *)pBuffer;
+    REPLY_053B_t      Reply;
+
+    if (pCmd->Page > FRAME_LINES)
+        return;
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID      = 0x053C;
+    Reply.Header.Size    = sizeof(Reply.Data);
+    Reply.Data.Page      = pCmd->Page;
+    Reply.Data.FrameCrc  = CRC_Calculate(gFrameBuffer, sizeof(gFrameBuffer));
+    Reply.Data.StatusCrc = CRC_Calculate(gStatusLine, sizeof(gStatusLine));
+    memcpy(Reply.Data.Data, pCmd->Page ? gFrameBuffer[pCmd->Page - 1] : gStatusLine, LCD_WIDTH);
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+
+static void CMD_053D(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_053D_t *pCmd = (const CMD_053D_t *)pBuffer;
+    REPLY_053D_t      Reply;
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x053E;
+    Reply.Header.Size = sizeof(Reply.Data);
+
+#ifdef ENABLE_PRIORITY_WATCH
+    for (unsigned int i = 0; i < WATCH_SLOT_N; i++) {
+        Reply.Data.Watch[i].Visits     = gWatchStats[i].visits;
+        Reply.Data.Watch[i].Hits       = gWatchStats[i].hits;
+        Reply.Data.Watch[i].MaxRevisit = gWatchStats[i].maxRevisit_10ms;
+    }
+
+    if (pCmd->bReset)
+        memset(gWatchStats, 0, sizeof(gWatchStats));
+#endif
+
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+    Reply.Data.SleepCycles = gPowerSaveStats.sleepCycles;
+    Reply.Data.QuietWakes  = gPowerSaveStats.quietWakes;
+    Reply.Data.ActiveWakes = gPowerSaveStats.activeWakes;
+    Reply.Data.MissedRisk  = gPowerSaveStats.missedRisk_10ms;
+    Reply.Data.Sleep_10ms  = gPowerSaveStats.sleep_10ms;
+
+    if (pCmd->bReset)
+        memset(&gPowerSaveStats, 0, sizeof(gPowerSaveStats));
+#endif
+
+#if !defined(ENABLE_PRIORITY_WATCH) && !defined(ENABLE_ADAPTIVE_POWER_SAVE)
+    UNUSED(pCmd);
+#endif
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+#endif
+
+#ifdef ENABLE_DTMF_LOG
+static void CMD_053F(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_053F_t *pCmd = (const CMD_053F_t *)pBuffer;
+    REPLY_053F_t      Reply;
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID          = 0x0540;
+    Reply.Header.Size        = sizeof(Reply.Data);
+    Reply.Data.NextSeq       = DTMF_GetLogSeq();
+    Reply.Data.EventsDropped = gDTMF_EventsDropped;
+    Reply.Data.Count         = DTMF_ReadLog(pCmd->Index, Reply.Data.Record, DTMF_LOG_REPLY_RECORDS);
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+#endif
+
+#ifdef ENABLE_AM_FIX__
+static void CMD_0537(uint32_t Port, const uint8_t *pBuffer)
+{
+    const CMD_0537_t *pCmd = (const CMD_0537_t *)pBuffer;
+    REPLY_0537_t      Reply;
+
+    memset(&Reply, 0, sizeof(Reply));
+    Reply.Header.ID   = 0x0538;
+    Reply.Header.Size = sizeof(Reply.Data);
+    Reply.Data.Count  = gAM_fixTrace.count;
+
+    unsigned int slot = (gAM_fixTrace.head + AM_FIX_TRACE_SIZE - gAM_fixTrace.count) % AM_FIX_TRACE_SIZE;
+    for (unsigned int i = 0; i < gAM_fixTrace.count; i++) {
+        Reply.Data.Sample[i] = gAM_fixTrace.sample[slot];
+        slot = (slot + 1) % AM_FIX_TRACE_SIZE;
+    }
+
+    if (pCmd->bClear)
+        gAM_fixTrace.count = 0;
+
+    SendReply(Port, &Reply, sizeof(Reply));
+}
+#endif
+
 #ifdef ENABLE_UART_RW_BK_REGS
 static void CMD_0601_ReadBK4819Reg(uint32_t Port, const uint8_t *pBuffer)
 {
@@ -823,6 +1164,36 @@ void UART_HandleCommand(uint32_t Port)
             break;
 #endif
 
+#ifdef ENABLE_PROFILER
+        case 0x0535:
+            CMD_0535(Port, pUART_Command->Buffer);
+            break;
+
+        case 0x0539:
+            CMD_0539(Port, pUART_Command->Buffer);
+            break;
+
+        case 0x053B:
+            CMD_053B(Port, pUART_Command->Buffer);
+            break;
+
+        case 0x053D:
+            CMD_053D(Port, pUART_Command->Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_DTMF_LOG
+        case 0x053F:
+            CMD_053F(Port, pUART_Command->Buffer);
+            break;
+#endif
+
+#ifdef ENABLE_AM_FIX__
+        case 0x0537:
+            CMD_0537(Port, pUART_Command->Buffer);
+            break;
+#endif
+
         case 0x05DD: // reset
             #if defined(ENABLE_OVERLAY)
                 overlay_FLASH_RebootToBootloader();
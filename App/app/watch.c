@@ -0,0 +1,247 @@
+#ifdef ENABLE_PRIORITY_WATCH
+
+#include "app/chFrScanner.h"
+#include "app/watch.h"
+#include "driver/bk4819.h"
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+#include "scheduler.h"
+#include "settings.h"
+
+#ifdef ENABLE_FMRADIO
+    #include "app/fm.h"
+#endif
+
+WATCH_SlotStats_t gWatchStats[WATCH_SLOT_N];
+
+static uint32_t lastVisit[WATCH_SLOT_N];
+static uint16_t countdown_10ms;
+static uint8_t  dwell_10ms;
+static uint8_t  nextPriority;
+static int16_t  peekChannel = -1;
+static uint32_t peekFrequency;
+static uint8_t  peekFunction;
+static uint16_t savedAF;
+static uint16_t savedMask;
+static uint16_t peekAF;
+static int16_t  hitChannel = -1;
+static uint8_t  hitVfo;
+static uint8_t  savedScreenChannel;
+static uint8_t  savedMrChannel;
+static uint16_t hang_10ms;
+
+void WATCH_Visit(WATCH_Slot_t slot)
+{
+    const uint32_t now = gGlobalSysTickCounter;
+
+    if (lastVisit[slot] != 0 && now - lastVisit[slot] > gWatchStats[slot].maxRevisit_10ms)
+        gWatchStats[slot].maxRevisit_10ms = (now - lastVisit[slot] > UINT16_MAX) ? UINT16_MAX : now - lastVisit[slot];
+
+    lastVisit[slot] = now;
+    gWatchStats[slot].visits++;
+}
+
+bool WATCH_IsPeeking(void)
+{
+    return peekChannel >= 0;
+}
+
+static int GetPriorityChannel(unsigned int index)
+{
+    const uint8_t list = gEeprom.SCAN_LIST_DEFAULT;
+
+    if (list < 1 || list > 3 || !gEeprom.SCAN_LIST_ENABLED[list - 1])
+        return -1;
+
+    const uint8_t chan = index ? gEeprom.SCANLIST_PRIORITY_CH2[list - 1] : gEeprom.SCANLIST_PRIORITY_CH1[list - 1];
+
+    if (!RADIO_CheckValidChannel(chan, false, list))
+        return -1;
+
+    return chan;
+}
+
+static bool CanPeek(void)
+{
+    if (gEeprom.DUAL_WATCH == DUAL_WATCH_OFF || gScanStateDir != SCAN_OFF || gCssBackgroundScan || gMonitor)
+        return false;
+
+#ifdef ENABLE_FMRADIO
+    if (gFmRadioMode)
+        return false;
+#endif
+
+#ifdef ENABLE_NOAA
+    if (gIsNoaaMode)
+        return false;
+#endif
+
+    if (gCurrentFunction == FUNCTION_RECEIVE)
+        return true;
+
+    // keep the whole peek inside one dual watch dwell so the swap never
+    // lands on top of the borrowed tuning
+    return gCurrentFunction == FUNCTION_FOREGROUND &&
+           !gScheduleDualWatch &&
+           gDualWatchCountdown_10ms > watch_priority_dwell_10ms + 2;
+}
+
+static void StartPeek(int channel)
+{
+    const uint32_t Frequency = SETTINGS_FetchChannelFrequency(channel);
+
+    savedAF   = BK4819_GetShadow(BK4819_REG_47);
+    savedMask = BK4819_GetShadow(BK4819_REG_3F);
+
+    BK4819_WriteRegister(BK4819_REG_3F, 0);
+    if (gCurrentFunction == FUNCTION_RECEIVE)
+        BK4819_SetAF(BK4819_AF_MUTE);
+
+    BK4819_SetFrequency(Frequency);
+    BK4819_PickRXFilterPathBasedOnFrequency(Frequency);
+    BK4819_RX_TurnOn();
+
+    peekAF        = BK4819_GetShadow(BK4819_REG_47);
+    peekChannel   = channel;
+    peekFrequency = Frequency;
+    peekFunction  = gCurrentFunction;
+    dwell_10ms    = watch_priority_dwell_10ms;
+}
+
+// false when something else retuned the chip while we were away,
+// its setup then already owns the registers we borrowed
+static bool StillTuned(void)
+{
+    return BK4819_GetShadow(BK4819_REG_38) == (uint16_t)(peekFrequency >>  0) &&
+           BK4819_GetShadow(BK4819_REG_39) == (uint16_t)(peekFrequency >> 16);
+}
+
+static void MoveVfo(unsigned int vfo, uint8_t screenChannel, uint8_t mrChannel)
+{
+    gEeprom.MrChannel[vfo]     = mrChannel;
+    gEeprom.ScreenChannel[vfo] = screenChannel;
+    RADIO_ConfigureChannel(vfo, VFO_CONFIGURE_RELOAD);
+    gFlagReconfigureVfos = true;
+    gUpdateDisplay       = true;
+}
+
+// hand the main VFO back once the priority channel has been quiet for a
+// while, unless the user has since tuned it somewhere else
+static void CheckHit(void)
+{
+    if (gEeprom.ScreenChannel[hitVfo] != hitChannel) {
+        hitChannel = -1;
+        return;
+    }
+
+    if (FUNCTION_IsRx() || gCurrentFunction == FUNCTION_TRANSMIT) {
+        hang_10ms = watch_priority_hang_10ms;
+        return;
+    }
+
+    if (hang_10ms > 0 && --hang_10ms > 0)
+        return;
+
+    hitChannel = -1;
+    MoveVfo(hitVfo, savedScreenChannel, savedMrChannel);
+}
+
+// the audio and interrupt mask are only put back if nobody rewrote
+// them in the meantime, a sleeping chip is retuned but not woken
+static void EndPeek(void)
+{
+    const uint32_t Frequency = gRxVfo->pRX->Frequency;
+
+    BK4819_SetFrequency(Frequency);
+    BK4819_PickRXFilterPathBasedOnFrequency(Frequency);
+    if (gCurrentFunction != FUNCTION_POWER_SAVE)
+        BK4819_RX_TurnOn();
+
+    if (BK4819_GetShadow(BK4819_REG_47) == peekAF)
+        BK4819_WriteRegister(BK4819_REG_47, savedAF);
+    if (BK4819_GetShadow(BK4819_REG_3F) == 0)
+        BK4819_WriteRegister(BK4819_REG_3F, savedMask);
+
+    peekChannel = -1;
+}
+
+void WATCH_TimeSlice10ms(void)
+{
+    if (hitChannel >= 0 && peekChannel < 0)
+        CheckHit();
+
+    if (peekChannel >= 0) {
+        if (!StillTuned()) {
+            peekChannel = -1;
+            return;
+        }
+
+        // a function change without a retune (e.g. into power save)
+        // still needs the borrowed registers back
+        if (gCurrentFunction != peekFunction) {
+            EndPeek();
+            return;
+        }
+
+        if (dwell_10ms > 0 && --dwell_10ms > 0)
+            return;
+
+        const int          channel = peekChannel;
+        const WATCH_Slot_t slot    = (channel == GetPriorityChannel(0)) ? WATCH_SLOT_PRIORITY_1 : WATCH_SLOT_PRIORITY_2;
+        const bool         open    = BK4819_IsSquelchOpen();
+
+        EndPeek();
+        WATCH_Visit(slot);
+
+        if (open) {
+            const unsigned int vfo = gEeprom.TX_VFO;
+
+            gWatchStats[slot].hits++;
+
+            if (hitChannel >= 0 && hitVfo != vfo)
+                MoveVfo(hitVfo, savedScreenChannel, savedMrChannel);
+
+            if (hitChannel < 0 || hitVfo != vfo) {
+                hitVfo             = vfo;
+                savedScreenChannel = gEeprom.ScreenChannel[vfo];
+                savedMrChannel     = gEeprom.MrChannel[vfo];
+            }
+            hitChannel = channel;
+            hang_10ms  = watch_priority_hang_10ms;
+
+            // move the main VFO onto the busy priority channel and let the
+            // normal squelch interrupts take the reception from there
+            MoveVfo(vfo, channel, channel);
+        }
+        return;
+    }
+
+    if (countdown_10ms > 0) {
+        countdown_10ms--;
+        return;
+    }
+
+    if (!CanPeek())
+        return;
+
+    countdown_10ms = (gCurrentFunction == FUNCTION_RECEIVE) ? watch_priority_rx_10ms : watch_priority_idle_10ms;
+
+    for (unsigned int i = 0; i < 2; i++) {
+        const unsigned int index   = (nextPriority + i) & 1u;
+        const int          channel = GetPriorityChannel(index);
+
+        if (channel < 0 || channel == gRxVfo->CHANNEL_SAVE)
+            continue;
+
+        // a priority 1 reception is never interrupted for priority 2
+        if (index == 1 && gCurrentFunction == FUNCTION_RECEIVE && gRxVfo->CHANNEL_SAVE == GetPriorityChannel(0))
+            continue;
+
+        nextPriority = index + 1;
+        StartPeek(channel);
+        return;
+    }
+}
+
+#endif
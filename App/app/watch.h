@@ -0,0 +1,33 @@
+#ifndef APP_WATCH_H
+#define APP_WATCH_H
+
+#ifdef ENABLE_PRIORITY_WATCH
+
+#include <stdbool.h>
+#include <stdint.h>
+
+enum WATCH_Slot_t {
+    WATCH_SLOT_VFO_A = 0,
+    WATCH_SLOT_VFO_B,
+    WATCH_SLOT_PRIORITY_1,
+    WATCH_SLOT_PRIORITY_2,
+    WATCH_SLOT_N
+};
+
+typedef enum WATCH_Slot_t WATCH_Slot_t;
+
+typedef struct {
+    uint16_t visits;
+    uint16_t hits;
+    uint16_t maxRevisit_10ms;   // longest gap seen between two samples of this slot
+} WATCH_SlotStats_t;
+
+extern WATCH_SlotStats_t gWatchStats[WATCH_SLOT_N];
+
+void WATCH_Visit(WATCH_Slot_t slot);
+bool WATCH_IsPeeking(void);
+void WATCH_TimeSlice10ms(void);
+
+#endif
+
+#endif
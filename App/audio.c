@@ -1,5 +1,7 @@
  
 
+#include <string.h>
+
 #ifdef ENABLE_FMRADIO
     #include "app/fm.h"
 #endif
@@ -21,6 +23,146 @@
 
 BEEP_Type_t gBeepToPlay = BEEP_NONE;
 
+typedef struct
+{
+    bool bTx;
+    void (*Begin)(void);
+    void (*Step)(const AUDIO_ToneStep_t *pStep, uint8_t Index);
+    void (*End)(void);
+} ToneOutput_t;
+
+#define TONE_QUEUE_LEN 16
+#define BEEP_LEVEL     28
+
+static AUDIO_ToneStep_t    gToneQueue[TONE_QUEUE_LEN];
+static uint8_t             gToneCount;
+static uint8_t             gToneIndex;
+static uint8_t             gToneCountdown_10ms;
+static const ToneOutput_t *gToneOutput;
+static void              (*gToneDone)(void);
+static BEEP_Type_t         gBeepPending = BEEP_NONE;
+static uint16_t            gBeepToneConfig;
+
+static void QueueTone(uint16_t Frequency, uint8_t Level, uint8_t Duration_10ms)
+{
+    if (gToneCount < TONE_QUEUE_LEN)
+        gToneQueue[gToneCount++] = (AUDIO_ToneStep_t){Frequency, Level, Duration_10ms};
+}
+
+static void ApplyTone(void)
+{
+    gToneOutput->Step(&gToneQueue[gToneIndex], gToneIndex);
+    gToneCountdown_10ms = gToneQueue[gToneIndex].Duration_10ms;
+}
+
+static void StartTone(const ToneOutput_t *pOutput, void (*pDone)(void))
+{
+    gToneOutput = pOutput;
+    gToneDone   = pDone;
+    gToneIndex  = 0;
+    pOutput->Begin();
+    ApplyTone();
+}
+
+static void FinishTone(void)
+{
+    const ToneOutput_t *pOutput = gToneOutput;
+    void (*pDone)(void)         = gToneDone;
+
+    gToneOutput = NULL;
+    gToneCount  = 0;
+    pOutput->End();
+    if (pDone)
+        pDone();
+}
+
+bool AUDIO_IsTonePlaying(void)
+{
+    return gToneOutput != NULL;
+}
+
+void AUDIO_StopTone(bool bTxOnly)
+{
+    if (gToneOutput == NULL || (bTxOnly && !gToneOutput->bTx))
+        return;
+
+    FinishTone();
+}
+
+void AUDIO_ToneTimeSlice10ms(void)
+{
+    if (gToneOutput != NULL) {
+        if (--gToneCountdown_10ms > 0)
+            return;
+
+        if (++gToneIndex < gToneCount) {
+            ApplyTone();
+            return;
+        }
+
+        FinishTone();
+    }
+
+    // also picks up a beep that was waiting behind an aborted sequence
+    if (gBeepPending != BEEP_NONE) {
+        const BEEP_Type_t Beep = gBeepPending;
+        gBeepPending = BEEP_NONE;
+        AUDIO_PlayBeep(Beep);
+    }
+}
+
+// the first step of a speaker sequence is a gap with the amplifier still off
+static void BeepBegin(void)
+{
+#ifdef ENABLE_FMRADIO
+    if (gFmRadioMode)
+        BK1080_Mute(true);
+#endif
+
+    AUDIO_AudioPathOff();
+
+    if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
+        BK4819_RX_TurnOn();
+
+    // steps 0 and 1 are the settle gaps, step 2 the first tone
+    gBeepToneConfig = BK4819_ReadRegister(BK4819_REG_71);
+    BK4819_PlayTone(gToneQueue[2].Frequency, true);
+}
+
+static void BeepStep(const AUDIO_ToneStep_t *pStep, uint8_t Index)
+{
+    if (Index == 1)
+        AUDIO_AudioPathOn();
+
+    BK4819_SetTxTone(pStep->Frequency, pStep->Level);
+}
+
+static void BeepEnd(void)
+{
+    BK4819_EnterTxMute();
+    AUDIO_AudioPathOff();
+
+    BK4819_TurnsOffTones_TurnsOnRX();
+    BK4819_WriteRegister(BK4819_REG_71, gBeepToneConfig);
+
+    if (gEnableSpeaker)
+        AUDIO_AudioPathOn();
+
+#ifdef ENABLE_FMRADIO
+    if (gFmRadioMode)
+        BK1080_Mute(false);
+#endif
+
+    if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
+        BK4819_Sleep();
+
+#ifdef ENABLE_VOX
+    gVoxResumeCountdown = 80;
+#endif
+}
+
+static const ToneOutput_t BeepOutput = {false, BeepBegin, BeepStep, BeepEnd};
+
 void AUDIO_PlayBeep(BEEP_Type_t Beep)
 {
 
@@ -50,19 +192,10 @@ void AUDIO_PlayBeep(BEEP_Type_t Beep)
     if (gCurrentFunction == FUNCTION_MONITOR)
         return;
 
-#ifdef ENABLE_FMRADIO
-    if (gFmRadioMode)
-        BK1080_Mute(true);
-#endif
-
-    AUDIO_AudioPathOff();
-
-    if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
-        BK4819_RX_TurnOn();
-
-    SYSTEM_DelayMs(20);
-
-    uint16_t ToneConfig = BK4819_ReadRegister(BK4819_REG_71);
+    if (gToneOutput != NULL && gToneOutput != &BeepOutput) {
+        gBeepPending = Beep;
+        return;
+    }
 
     uint16_t ToneFrequency;
     switch (Beep)
@@ -101,95 +234,168 @@ void AUDIO_PlayBeep(BEEP_Type_t Beep)
 #endif
     }
 
-    if(Beep == BEEP_400HZ_30MS || Beep == BEEP_500HZ_30MS || Beep == BEEP_600HZ_30MS)
-    {
-        BK4819_WriteRegister(BK4819_REG_70, BK4819_REG_70_ENABLE_TONE1 | ((1 & 0x7f) << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
+    // a beep asked for while one is playing is appended to it
+    const bool bAppend = gToneOutput != NULL;
+    if (!bAppend) {
+        gToneCount = 0;
+        QueueTone(0, BEEP_LEVEL, 2);
+        QueueTone(0, BEEP_LEVEL, 6);
     }
 
-    BK4819_PlayTone(ToneFrequency, true);
-
-    SYSTEM_DelayMs(2);
-
-    AUDIO_AudioPathOn();
-
-    SYSTEM_DelayMs(60);
-
-    uint16_t Duration;
+    uint8_t Duration_10ms;
     switch (Beep)
     {
         case BEEP_880HZ_60MS_DOUBLE_BEEP:
-            BK4819_ExitTxMute();
-            SYSTEM_DelayMs(60);
-            BK4819_EnterTxMute();
-            SYSTEM_DelayMs(20);
+            QueueTone(ToneFrequency, BEEP_LEVEL, 6);
+            QueueTone(0, BEEP_LEVEL, 2);
             [[fallthrough]];
         case BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL:
         case BEEP_500HZ_60MS_DOUBLE_BEEP:
-            BK4819_ExitTxMute();
-            SYSTEM_DelayMs(60);
-            BK4819_EnterTxMute();
-            SYSTEM_DelayMs(20);
+            QueueTone(ToneFrequency, BEEP_LEVEL, 6);
+            QueueTone(0, BEEP_LEVEL, 2);
             [[fallthrough]];
         case BEEP_1KHZ_60MS_OPTIONAL:
-            BK4819_ExitTxMute();
-            Duration = 60;
+            Duration_10ms = 6;
             break;
 #ifdef ENABLE_FEAT_F4HWN
         case BEEP_400HZ_30MS:
         case BEEP_500HZ_30MS:
         case BEEP_600HZ_30MS:
-            BK4819_ExitTxMute();
-            Duration = 30;
+            Duration_10ms = 3;
             break;
 #endif
         case BEEP_440HZ_500MS:
 #ifndef ENABLE_FEAT_F4HWN
         case BEEP_880HZ_200MS:
-            BK4819_ExitTxMute();
-            Duration = 200;
+            Duration_10ms = 20;
             break;
         case BEEP_880HZ_500MS:
 #endif
         default:
-            BK4819_ExitTxMute();
-            Duration = 500;
+            Duration_10ms = 50;
             break;
     }
 
-    SYSTEM_DelayMs(Duration);
-    BK4819_EnterTxMute();
-    SYSTEM_DelayMs(20);
+    QueueTone(ToneFrequency, BEEP_LEVEL, Duration_10ms);
+    QueueTone(0, BEEP_LEVEL, 2);
+
+    if (!bAppend)
+        StartTone(&BeepOutput, NULL);
+}
+
+static void RogerBegin(void)
+{
+    BK4819_StartTxTone();
+}
+
+static void RogerStep(const AUDIO_ToneStep_t *pStep, __attribute__((unused)) uint8_t Index)
+{
+    BK4819_SetTxTone(pStep->Frequency, pStep->Level);
+}
+
+static void RogerEnd(void)
+{
+    BK4819_StopTxTone();
+}
+
+static const ToneOutput_t RogerOutput = {true, RogerBegin, RogerStep, RogerEnd};
+
+static void RogerMdcStep(__attribute__((unused)) const AUDIO_ToneStep_t *pStep, uint8_t Index)
+{
+    if (Index == 1)
+        BK4819_StartRogerMDC();
+}
+
+static const ToneOutput_t RogerMdcOutput = {true, BK4819_PrepareRogerMDC, RogerMdcStep, BK4819_StopRogerMDC};
+
+bool AUDIO_PlayRoger(void (*pDone)(void))
+{
+    AUDIO_StopTone(false);
+    gToneCount = 0;
+
+    if (gEeprom.ROGER == ROGER_MODE_ROGER) {
+        QueueTone(0,    0x43, 5);
+        QueueTone(1540, 0x43, 8);
+        QueueTone(1310, 0x43, 8);
+        StartTone(&RogerOutput, pDone);
+        return true;
+    }
+
+    if (gEeprom.ROGER == ROGER_MODE_MDC) {
+        QueueTone(0, 0, 2);
+        QueueTone(0, 0, 18);
+        StartTone(&RogerMdcOutput, pDone);
+        return true;
+    }
+
+    return false;
+}
+
+#ifdef ENABLE_FEAT_F4HWN
+static void TxAlertBegin(void)
+{
+    BK4819_StartTxTone();
+    AUDIO_AudioPathOn();
+    BK4819_SetAF(BK4819_AF_BEEP);
+}
 
+static void TxAlertEnd(void)
+{
+    BK4819_EnterTxMute();
     AUDIO_AudioPathOff();
+    BK4819_SetAF(BK4819_AF_MUTE);
+    BK4819_StopTxTone();
+    BK4819_ExitTxMute();
+}
 
-    SYSTEM_DelayMs(5);
-    BK4819_TurnsOffTones_TurnsOnRX();
-    SYSTEM_DelayMs(5);
-    BK4819_WriteRegister(BK4819_REG_71, ToneConfig);
+static const ToneOutput_t TxAlertOutput = {true, TxAlertBegin, RogerStep, TxAlertEnd};
 
-    if (gEnableSpeaker)
-        AUDIO_AudioPathOn();
+void AUDIO_PlayTxAlert(uint16_t Frequency)
+{
+    if (gToneOutput != NULL)
+        return;
 
-#ifdef ENABLE_FMRADIO
-    if (gFmRadioMode)
-        BK1080_Mute(false);
+    gToneCount = 0;
+    QueueTone(0,         1, 5);
+    QueueTone(Frequency, 1, 3);
+    StartTone(&TxAlertOutput, NULL);
+}
 #endif
 
-    if (gCurrentFunction == FUNCTION_POWER_SAVE && gRxIdleMode)
-        BK4819_Sleep();
+#ifdef ENABLE_ALARM
+static void AlarmBegin(void)
+{
+    AUDIO_AudioPathOff();
+    BK4819_PlayTone(500, 0);
+}
 
-#ifdef ENABLE_VOX
-    gVoxResumeCountdown = 80;
-#endif
+static void AlarmStep(__attribute__((unused)) const AUDIO_ToneStep_t *pStep, uint8_t Index)
+{
+    if (Index == 1)
+        AUDIO_AudioPathOn();
+}
 
+static void AlarmEnd(void)
+{
+    BK4819_ExitTxMute();
 }
 
-#ifdef ENABLE_VOICE
+static const ToneOutput_t AlarmOutput = {false, AlarmBegin, AlarmStep, AlarmEnd};
+
+void AUDIO_PlayAlarmTone(void)
+{
+    AUDIO_StopTone(false);
+    gToneCount = 0;
 
-uint16_t gVoiceBuf[VOICE_BUF_CAP][VOICE_BUF_LEN];
-uint8_t gVoiceBufReadIndex = 0;
-uint8_t gVoiceBufWriteIndex = 0;
-uint8_t gVoiceBufLen = 0;
+    QueueTone(0, 0, 2);
+    QueueTone(0, 0, 6);
+    StartTone(&AlarmOutput, NULL);
+
+    gEnableSpeaker = true;
+}
+#endif
+
+#ifdef ENABLE_VOICE
 
 VOICE_ID_t        gVoiceID[8];
 uint8_t           gVoiceReadIndex;
@@ -198,46 +404,14 @@ volatile uint16_t gCountdownToPlayNextVoice_10ms;
 volatile bool     gFlagPlayQueuedVoice;
 VOICE_ID_t        gAnotherVoiceID = VOICE_ID_INVALID;
 
-static const uint16_t VOICE_SAMPLES[256] = 
-{
-    0x06a8, 0x06b8, 0x0688, 0x0698, 0x06e8, 0x06f8, 0x06c8, 0x06d8,  
-    0x0628, 0x0638, 0x0608, 0x0618, 0x0668, 0x0678, 0x0648, 0x0658,  
-    0x0754, 0x075c, 0x0744, 0x074c, 0x0774, 0x077c, 0x0764, 0x076c,  
-    0x0714, 0x071c, 0x0704, 0x070c, 0x0734, 0x073c, 0x0724, 0x072c,  
-    0x02a0, 0x02e0, 0x0220, 0x0260, 0x03a0, 0x03e0, 0x0320, 0x0360,  
-    0x00a0, 0x00e0, 0x0020, 0x0060, 0x01a0, 0x01e0, 0x0120, 0x0160,  
-    0x0550, 0x0570, 0x0510, 0x0530, 0x05d0, 0x05f0, 0x0590, 0x05b0,  
-    0x0450, 0x0470, 0x0410, 0x0430, 0x04d0, 0x04f0, 0x0490, 0x04b0,  
-    0x07ea, 0x07eb, 0x07e8, 0x07e9, 0x07ee, 0x07ef, 0x07ec, 0x07ed,  
-    0x07e2, 0x07e3, 0x07e0, 0x07e1, 0x07e6, 0x07e7, 0x07e4, 0x07e5,  
-    0x07fa, 0x07fb, 0x07f8, 0x07f9, 0x07fe, 0x07ff, 0x07fc, 0x07fd,  
-    0x07f2, 0x07f3, 0x07f0, 0x07f1, 0x07f6, 0x07f7, 0x07f4, 0x07f5,  
-    0x07aa, 0x07ae, 0x07a2, 0x07a6, 0x07ba, 0x07be, 0x07b2, 0x07b6,  
-    0x078a, 0x078e, 0x0782, 0x0786, 0x079a, 0x079e, 0x0792, 0x0796,  
-    0x07d5, 0x07d7, 0x07d1, 0x07d3, 0x07dd, 0x07df, 0x07d9, 0x07db,  
-    0x07c5, 0x07c7, 0x07c1, 0x07c3, 0x07cd, 0x07cf, 0x07c9, 0x07cb,  
-    0x0958, 0x0948, 0x0978, 0x0968, 0x0918, 0x0908, 0x0938, 0x0928,  
-    0x09d8, 0x09c8, 0x09f8, 0x09e8, 0x0998, 0x0988, 0x09b8, 0x09a8,  
-    0x08ac, 0x08a4, 0x08bc, 0x08b4, 0x088c, 0x0884, 0x089c, 0x0894,  
-    0x08ec, 0x08e4, 0x08fc, 0x08f4, 0x08cc, 0x08c4, 0x08dc, 0x08d4,  
-    0x0d60, 0x0d20, 0x0de0, 0x0da0, 0x0c60, 0x0c20, 0x0ce0, 0x0ca0,  
-    0x0f60, 0x0f20, 0x0fe0, 0x0fa0, 0x0e60, 0x0e20, 0x0ee0, 0x0ea0,  
-    0x0ab0, 0x0a90, 0x0af0, 0x0ad0, 0x0a30, 0x0a10, 0x0a70, 0x0a50,  
-    0x0bb0, 0x0b90, 0x0bf0, 0x0bd0, 0x0b30, 0x0b10, 0x0b70, 0x0b50,  
-    0x0815, 0x0814, 0x0817, 0x0816, 0x0811, 0x0810, 0x0813, 0x0812,  
-    0x081d, 0x081c, 0x081f, 0x081e, 0x0819, 0x0818, 0x081b, 0x081a,  
-    0x0805, 0x0804, 0x0807, 0x0806, 0x0801, 0x0800, 0x0803, 0x0802,  
-    0x080d, 0x080c, 0x080f, 0x080e, 0x0809, 0x0808, 0x080b, 0x080a,  
-    0x0856, 0x0852, 0x085e, 0x085a, 0x0846, 0x0842, 0x084e, 0x084a,  
-    0x0876, 0x0872, 0x087e, 0x087a, 0x0866, 0x0862, 0x086e, 0x086a,  
-    0x082b, 0x0829, 0x082f, 0x082d, 0x0823, 0x0821, 0x0827, 0x0825,  
-    0x083b, 0x0839, 0x083f, 0x083d, 0x0833, 0x0831, 0x0837, 0x0835  
-};
+// bit 31 of a clip's size word marks 4-bit IMA ADPCM, otherwise 8-bit A-law
+#define VOICE_CLIP_ADPCM 0x80000000U
 
 static struct
 {
     uint32_t Addr;
     uint32_t Size;
+    bool     bAdpcm;
 } VoiceClipState = {0};
 
 static bool LoadVoiceClip(uint8_t VoiceID)
@@ -255,71 +429,82 @@ static bool LoadVoiceClip(uint8_t VoiceID)
     } Info;
     PY25Q16_ReadBuffer(Addr + 8 * VoiceID, &Info, 8);
 
+    const bool bAdpcm = (Info.Size & VOICE_CLIP_ADPCM) != 0;
+    Info.Size &= ~VOICE_CLIP_ADPCM;
+
     if (Info.Offset > 0x0b0000 || Info.Size > 0x019000)
     {
         return false;
     }
 
-    VoiceClipState.Addr = 0x14d000 + Info.Offset;
-    VoiceClipState.Size = Info.Size;
+    VoiceClipState.Addr   = 0x14d000 + Info.Offset;
+    VoiceClipState.Size   = Info.Size;
+    VoiceClipState.bAdpcm = bAdpcm;
     return true;
 }
 
-static inline uint32_t CalcDelay(uint32_t Size)
+// clip length in 10ms ticks at the 8kHz DAC rate
+static inline uint16_t CalcDelay(uint32_t Size, bool bAdpcm)
 {
-    return 2 * Size;  
+    return bAdpcm ? Size / 40 : Size / 80;
 }
 
-static void LoadVoiceSamples()
+static void LoadVoiceSamples(void)
 {
-    if (0 == VoiceClipState.Addr || 0 == VoiceClipState.Size)
-    {
-        return;
-    }
-    if (gVoiceBufLen >= VOICE_BUF_CAP)
+    if (0 == VoiceClipState.Size || VOICE_BUF_Len() >= VOICE_BUF_CAP)
     {
         return;
     }
 
-    extern uint8_t **gFrameBuffer;
-    uint8_t *Buf = (uint8_t *)gFrameBuffer;
-    PY25Q16_ReadBuffer(VoiceClipState.Addr, Buf, VOICE_BUF_LEN);
-    VoiceClipState.Addr += VOICE_BUF_LEN;
-    VoiceClipState.Size -= VOICE_BUF_LEN;
+    const uint32_t SlotBytes = VOICE_SLOT_BYTES(VoiceClipState.bAdpcm);
+    const uint32_t Len       = MIN(VoiceClipState.Size, SlotBytes);
+    uint8_t       *pSlot     = VOICE_BUF_WriteSlot();
+
+    PY25Q16_ReadBuffer(VoiceClipState.Addr, pSlot, Len);
+    VoiceClipState.Addr += Len;
+    VoiceClipState.Size -= Len;
+
+    // pad the last chunk with silence: A-law zero, or +/- ADPCM steps that cancel
+    memset(pSlot + Len, VoiceClipState.bAdpcm ? 0x80 : 0xD5, SlotBytes - Len);
+
+    VOICE_BUF_ForwardWriteIndex();
+}
+
+static uint16_t AUDIO_PlayVoice(uint8_t VoiceID)
+{
+    VOICE_Stop();
 
-    for (uint32_t i = 0; i < VOICE_BUF_LEN; i++)
+    if (!LoadVoiceClip(VoiceID))
     {
-        gVoiceBuf[gVoiceBufWriteIndex][i] = VOICE_SAMPLES[Buf[i]];
+        return 0;
     }
-    VOICE_BUF_ForwardWriteIndex();
-    gVoiceBufLen++;
+
+    const uint16_t Delay = CalcDelay(VoiceClipState.Size, VoiceClipState.bAdpcm);
+
+    VOICE_Reset(VoiceClipState.bAdpcm);
+    for (uint8_t i = 0; i < VOICE_BUF_CAP; i++)
+        LoadVoiceSamples();
+    VOICE_Start();
+
+    return Delay;
+}
+
+void AUDIO_VoiceTimeSlice10ms(void)
+{
+    LoadVoiceSamples();
 }
 
 void AUDIO_PlaySingleVoice(bool bFlag)
 {
-    uint8_t VoiceID;
-    uint8_t Delay;
+    uint8_t  VoiceID;
+    uint16_t Delay;
 
     VoiceID = gVoiceID[0];
 
     if (gEeprom.VOICE_PROMPT != VOICE_PROMPT_OFF && gVoiceWriteIndex > 0)
     {
-        if (gEeprom.VOICE_PROMPT == VOICE_PROMPT_CHINESE)
-        {    
-            if (VoiceID >= ARRAY_SIZE(VoiceClipLengthChinese))
-                goto Bailout;
-
-            Delay    = VoiceClipLengthChinese[VoiceID];
-            VoiceID += VOICE_ID_CHI_BASE;
-        }
-        else
-        {    
-            if (VoiceID >= ARRAY_SIZE(VoiceClipLengthEnglish))
-                goto Bailout;
-
-            Delay    = VoiceClipLengthEnglish[VoiceID];
-            VoiceID += VOICE_ID_ENG_BASE;
-        }
+        if (VoiceID >= VOICE_ID_END)
+            goto Bailout;
 
         if (FUNCTION_IsRx())    
             BK4819_SetAF(BK4819_AF_MUTE);
@@ -336,14 +521,19 @@ void AUDIO_PlaySingleVoice(bool bFlag)
         #endif
 
         SYSTEM_DelayMs(5);
-        AUDIO_PlayVoice(VoiceID);
+        Delay = AUDIO_PlayVoice(VoiceID);
 
         if (gVoiceWriteIndex == 1)
             Delay += 3;
 
         if (bFlag)
         {
-            SYSTEM_DelayMs(Delay * 10);
+            while (Delay-- > 0)
+            {
+                SYSTEM_DelayMs(10);
+                LoadVoiceSamples();
+            }
+            VOICE_Stop();
 
             if (FUNCTION_IsRx())     
                 RADIO_SetModulation(gRxVfo->Modulation);
@@ -434,45 +624,22 @@ Skip:
 
 void AUDIO_PlayQueuedVoice(void)
 {
-    uint8_t VoiceID;
-    uint8_t Delay;
-    bool    Skip;
-
-    Skip = false;
+    uint8_t  VoiceID;
+    uint16_t Delay;
 
     if (gVoiceReadIndex != gVoiceWriteIndex && gEeprom.VOICE_PROMPT != VOICE_PROMPT_OFF)
     {
         VoiceID = gVoiceID[gVoiceReadIndex];
-        if (gEeprom.VOICE_PROMPT == VOICE_PROMPT_CHINESE)
-        {
-            if (VoiceID < ARRAY_SIZE(VoiceClipLengthChinese))
-            {
-                Delay = VoiceClipLengthChinese[VoiceID];
-                VoiceID += VOICE_ID_CHI_BASE;
-            }
-            else
-                Skip = true;
-        }
-        else
-        {
-            if (VoiceID < ARRAY_SIZE(VoiceClipLengthEnglish))
-            {
-                Delay = VoiceClipLengthEnglish[VoiceID];
-                VoiceID += VOICE_ID_ENG_BASE;
-            }
-            else
-                Skip = true;
-        }
 
         gVoiceReadIndex++;
 
-        if (!Skip)
+        if (VoiceID < VOICE_ID_END)
         {
+            Delay = AUDIO_PlayVoice(VoiceID);
+
             if (gVoiceReadIndex == gVoiceWriteIndex)
                 Delay += 3;
 
-            AUDIO_PlayVoice(VoiceID);
-
             gCountdownToPlayNextVoice_10ms = Delay;
             gFlagPlayQueuedVoice           = false;
 
@@ -484,6 +651,8 @@ void AUDIO_PlayQueuedVoice(void)
         }
     }
 
+    VOICE_Stop();
+
     if (FUNCTION_IsRx())
     {
         RADIO_SetModulation(gRxVfo->Modulation);  
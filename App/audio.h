@@ -31,7 +31,24 @@ typedef enum BEEP_Type_t BEEP_Type_t;
 
 extern BEEP_Type_t       gBeepToPlay;
 
+typedef struct
+{
+    uint16_t Frequency;      // 0 mutes the tone for the step
+    uint8_t  Level;          // BK4819 tone1 tuning gain
+    uint8_t  Duration_10ms;
+} AUDIO_ToneStep_t;
+
 void AUDIO_PlayBeep(BEEP_Type_t Beep);
+bool AUDIO_PlayRoger(void (*pDone)(void));
+#ifdef ENABLE_FEAT_F4HWN
+    void AUDIO_PlayTxAlert(uint16_t Frequency);
+#endif
+#ifdef ENABLE_ALARM
+    void AUDIO_PlayAlarmTone(void);
+#endif
+bool AUDIO_IsTonePlaying(void);
+void AUDIO_StopTone(bool bTxOnly);
+void AUDIO_ToneTimeSlice10ms(void);
 
 #define AUDIO_AudioPathOn() GPIO_EnableAudioPath()
 
@@ -139,6 +156,7 @@ void AUDIO_PlayBeep(BEEP_Type_t Beep);
     void    AUDIO_SetVoiceID(uint8_t Index, VOICE_ID_t VoiceID);
     uint8_t AUDIO_SetDigitVoice(uint8_t Index, uint16_t Value);
     void    AUDIO_PlayQueuedVoice(void);
+    void    AUDIO_VoiceTimeSlice10ms(void);
 #endif
 
 #endif
@@ -10,6 +10,11 @@
 #include "py32f071_ll_gpio.h"
 #include "py32f071_ll_rcc.h"
 #include "py32f071_ll_adc.h"
+#ifdef ENABLE_BATTERY_ADC_DMA
+    #include "py32f071_ll_dma.h"
+    #include "py32f071_ll_system.h"
+    #include "py32f071_ll_tim.h"
+#endif
 #include "driver/voice.h"
 #include "driver/backlight.h"
 #ifdef ENABLE_FMRADIO
@@ -20,6 +25,7 @@
 #include "driver/py25q16.h"
 #include "driver/flash.h"
 #include "driver/gpio.h"
+#include "driver/keyboard.h"
 #include "driver/system.h"
 #include "driver/st7565.h"
 #include "frequencies.h"
@@ -110,6 +116,61 @@ void BOARD_GPIO_Init(void)
 #endif  
 }
 
+#ifdef ENABLE_BATTERY_ADC_DMA
+// TIM3 triggers a conversion every 500 us and DMA keeps the last 32 ms
+// of samples, readers average the ring instead of waiting on the ADC
+#define ADC_TIMx            TIM3
+#define ADC_DMA_CHANNEL     LL_DMA_CHANNEL_1
+#define ADC_SAMPLE_RATE_HZ  2000
+#define ADC_SAMPLES_LOG2    6
+
+static volatile uint16_t gBatterySamples[1u << ADC_SAMPLES_LOG2];
+
+static void BOARD_ADC_StartSampling(void)
+{
+    LL_ADC_REG_StartConversionSWStart(ADC1);
+    while (!LL_ADC_IsActiveFlag_EOS(ADC1))
+        ;
+
+    // seed the ring so the first readings are not averaged with zeros
+    const uint16_t Sample = LL_ADC_REG_ReadConversionData12(ADC1);
+    for (unsigned int i = 0; i < ARRAY_SIZE(gBatterySamples); i++)
+        gBatterySamples[i] = Sample;
+
+    LL_AHB1_GRP1_EnableClock(LL_AHB1_GRP1_PERIPH_DMA1);
+    LL_APB1_GRP2_EnableClock(LL_APB1_GRP2_PERIPH_SYSCFG);
+
+    LL_DMA_DisableChannel(DMA1, ADC_DMA_CHANNEL);
+    LL_SYSCFG_SetDMARemap(DMA1, ADC_DMA_CHANNEL, LL_SYSCFG_DMA_MAP_ADC1);
+
+    LL_DMA_ConfigTransfer(DMA1, ADC_DMA_CHANNEL,
+                          LL_DMA_DIRECTION_PERIPH_TO_MEMORY
+                              | LL_DMA_MODE_CIRCULAR
+                              | LL_DMA_PERIPH_NOINCREMENT
+                              | LL_DMA_MEMORY_INCREMENT
+                              | LL_DMA_PDATAALIGN_HALFWORD
+                              | LL_DMA_MDATAALIGN_HALFWORD
+                              | LL_DMA_PRIORITY_LOW
+    );
+
+    LL_DMA_SetMemoryAddress(DMA1, ADC_DMA_CHANNEL, (uint32_t)gBatterySamples);
+    LL_DMA_SetPeriphAddress(DMA1, ADC_DMA_CHANNEL, LL_ADC_DMA_GetRegAddr(ADC1, LL_ADC_DMA_REG_REGULAR_DATA));
+    LL_DMA_SetDataLength(DMA1, ADC_DMA_CHANNEL, ARRAY_SIZE(gBatterySamples));
+    LL_DMA_EnableChannel(DMA1, ADC_DMA_CHANNEL);
+
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM3);
+    LL_TIM_SetPrescaler(ADC_TIMx, SystemCoreClock / 1000000 - 1);
+    LL_TIM_SetAutoReload(ADC_TIMx, 1000000 / ADC_SAMPLE_RATE_HZ - 1);
+    LL_TIM_SetTriggerOutput(ADC_TIMx, LL_TIM_TRGO_UPDATE);
+
+    LL_ADC_REG_SetTriggerSource(ADC1, LL_ADC_REG_TRIG_EXT_TIM3_TRGO);
+    LL_ADC_REG_SetDMATransfer(ADC1, LL_ADC_REG_DMA_TRANSFER_UNLIMITED);
+    LL_ADC_REG_StartConversionExtTrig(ADC1, LL_ADC_REG_TRIG_EXT_RISING);
+
+    LL_TIM_EnableCounter(ADC_TIMx);
+}
+#endif
+
 void BOARD_ADC_Init(void)
 {
     LL_IOP_GRP1_EnableClock(LL_IOP_GRP1_PERIPH_GPIOB);
@@ -136,10 +197,23 @@ void BOARD_ADC_Init(void)
         ;
 
     LL_ADC_Enable(ADC1);
+
+#ifdef ENABLE_BATTERY_ADC_DMA
+    BOARD_ADC_StartSampling();
+#endif
 }
 
 void BOARD_ADC_GetBatteryInfo(uint16_t *pVoltage, uint16_t *pCurrent)
 {
+#ifdef ENABLE_BATTERY_ADC_DMA
+    uint32_t Sum = 0;
+
+    for (unsigned int i = 0; i < ARRAY_SIZE(gBatterySamples); i++)
+        Sum += gBatterySamples[i];
+
+    *pVoltage = (Sum + (1u << (ADC_SAMPLES_LOG2 - 1))) >> ADC_SAMPLES_LOG2;
+    *pCurrent = 0;
+#else
     LL_ADC_REG_StartConversionSWStart(ADC1);
     while (!LL_ADC_IsActiveFlag_EOS(ADC1))
         ;
@@ -147,11 +221,15 @@ void BOARD_ADC_GetBatteryInfo(uint16_t *pVoltage, uint16_t *pCurrent)
 
     *pVoltage = LL_ADC_REG_ReadConversionData12(ADC1);
     *pCurrent = 0;
+#endif
 }
 
 void BOARD_Init(void)
 {
     BOARD_GPIO_Init();
+#ifdef ENABLE_KEYBOARD_SCAN_IRQ
+    KEYBOARD_Init();
+#endif
     BACKLIGHT_InitHardware();
     BOARD_ADC_Init();
 #ifdef ENABLE_VOICE
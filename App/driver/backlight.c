@@ -25,7 +25,10 @@
 #define TIMx TIM7
 #define DMA_CHANNEL LL_DMA_CHANNEL_7
 
-static uint32_t dutyCycle[DUTY_CYCLE_LEVELS];
+// DUTY_CYCLE_LEVELS "on" words followed by as many "off" words, filled
+// once; the DMA window starts level words before the boundary, so a level
+// change only moves the window
+static uint32_t dutyCycle[DUTY_CYCLE_LEVELS * 2];
 
  
 uint16_t gBacklightCountdown_500ms = 0;
@@ -67,9 +70,12 @@ void BACKLIGHT_InitHardware()
                               | LL_DMA_PRIORITY_HIGH         
     );
 
-    LL_DMA_SetMemoryAddress(DMA1, DMA_CHANNEL, (uint32_t)dutyCycle);
+    for (uint32_t i = 0; i < DUTY_CYCLE_LEVELS * 2; i++)
+    {
+        dutyCycle[i] = i < DUTY_CYCLE_LEVELS ? DUTY_CYCLE_ON_VALUE : DUTY_CYCLE_OFF_VALUE;
+    }
+
     LL_DMA_SetPeriphAddress(DMA1, DMA_CHANNEL, (uint32_t)(&GPIO_PORT(GPIO_PIN_BACKLIGHT)->BSRR));
-    LL_DMA_SetDataLength(DMA1, DMA_CHANNEL, sizeof(dutyCycle) / sizeof(uint32_t));
 }
 
 static void BACKLIGHT_Sound(void)
@@ -192,14 +198,13 @@ void BACKLIGHT_SetBrightness(uint8_t brigtness)
         }
         else
         {
-            for (uint32_t i = 0; i < DUTY_CYCLE_LEVELS; i++)
-            {
-                dutyCycle[i] = i < level ? DUTY_CYCLE_ON_VALUE : DUTY_CYCLE_OFF_VALUE;
-            }
+            LL_DMA_DisableChannel(DMA1, DMA_CHANNEL);
+            LL_DMA_SetMemoryAddress(DMA1, DMA_CHANNEL, (uint32_t)&dutyCycle[DUTY_CYCLE_LEVELS - level]);
+            LL_DMA_SetDataLength(DMA1, DMA_CHANNEL, DUTY_CYCLE_LEVELS);
+            LL_DMA_EnableChannel(DMA1, DMA_CHANNEL);
 
             if (!LL_TIM_IsEnabledCounter(TIMx))
             {
-                LL_DMA_EnableChannel(DMA1, DMA_CHANNEL);
                 LL_TIM_EnableCounter(TIMx);
             }
         }
@@ -49,8 +49,27 @@ enum BK4819_CssScanResult_t
 
 typedef enum BK4819_CssScanResult_t BK4819_CssScanResult_t;
 
+// the register shadow costs 256 B of RAM, only keep it for its readers
+#if defined(ENABLE_FAST_DUAL_WATCH) || defined(ENABLE_PRIORITY_WATCH) || defined(ENABLE_AM_FIX__)
+    #define BK4819_REGISTER_SHADOW
+#endif
+
+#ifdef ENABLE_FAST_DUAL_WATCH
+#define BK4819_IMAGE_SIZE 40
+
+// ordered register writes that bring the chip into one VFO's RX state
+typedef struct {
+    uint8_t  count;
+    bool     valid;
+    uint16_t interruptMask;
+    uint8_t  reg[BK4819_IMAGE_SIZE];
+    uint16_t value[BK4819_IMAGE_SIZE];
+} BK4819_Image_t;
+#endif
+
  
 extern bool gRxIdleMode;
+extern uint32_t gBK4819_Transactions;
 
 void     BK4819_Init(void);
 uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register);
@@ -58,6 +77,13 @@ void     BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data);
 void     BK4819_SetRegValue(RegisterSpec s, uint16_t v);
 void     BK4819_WriteU8(uint8_t Data);
 void     BK4819_WriteU16(uint16_t Data);
+#ifdef ENABLE_FAST_DUAL_WATCH
+void     BK4819_CaptureImage(BK4819_Image_t *pImage);
+void     BK4819_ApplyImage(const BK4819_Image_t *pImage);
+#endif
+#ifdef BK4819_REGISTER_SHADOW
+uint16_t BK4819_GetShadow(BK4819_REGISTER_t Register);
+#endif
 
 void     BK4819_SetAGC(bool enable);
 void     BK4819_InitAGC(bool amModulation);
@@ -123,6 +149,7 @@ void     BK4819_PlayCDCSSTail(void);
 void     BK4819_PlayCTCSSTail(void);
 
 uint16_t BK4819_GetRSSI(void);
+bool     BK4819_IsSquelchOpen(void);
 int8_t   BK4819_GetRxGain_dB(void);
 int16_t  BK4819_GetRSSI_dBm(void);
 uint8_t  BK4819_GetGlitchIndicator(void);
@@ -149,7 +176,12 @@ uint8_t  BK4819_GetCTCType(void);
 void     BK4819_SendFSKData(uint16_t *pData);
 void     BK4819_PrepareFSKReceive(void);
 
-void     BK4819_PlayRoger(void);
+void     BK4819_StartTxTone(void);
+void     BK4819_SetTxTone(uint16_t Frequency, uint8_t Level);
+void     BK4819_StopTxTone(void);
+void     BK4819_PrepareRogerMDC(void);
+void     BK4819_StartRogerMDC(void);
+void     BK4819_StopRogerMDC(void);
 
 void     BK4819_Enable_AfDac_DiscMode_TxDsp(void);
 
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "settings.h"
 
@@ -28,6 +29,16 @@ static uint16_t gBK4819_GpioOutState;
 
 bool gRxIdleMode;
 
+uint32_t gBK4819_Transactions;
+
+#ifdef BK4819_REGISTER_SHADOW
+static uint16_t        gShadow[0x80];
+static uint8_t         gShadowKnown[0x80 / 8];
+#endif
+#ifdef ENABLE_FAST_DUAL_WATCH
+static BK4819_Image_t *pCapture;
+#endif
+
 static inline void CS_Assert()
 {
     GPIO_ResetOutputPin(PIN_CSN);
@@ -193,6 +204,8 @@ uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
     Value = BK4819_ReadU16();
     CS_Release();
 
+    gBK4819_Transactions++;
+
     SYSTICK_DelayUs(1);
 
     SCL_Set();
@@ -201,8 +214,107 @@ uint16_t BK4819_ReadRegister(BK4819_REGISTER_t Register)
     return Value;
 }
 
+#ifdef ENABLE_FAST_DUAL_WATCH
+// indirect registers select a sub-register with their own bits, so every
+// write counts and they are replayed in order rather than compared
+static bool IsIndirect(BK4819_REGISTER_t Register)
+{
+    return Register == BK4819_REG_07 || Register == BK4819_REG_08 || Register == BK4819_REG_30;
+}
+
+static void CaptureWrite(BK4819_REGISTER_t Register, uint16_t Data)
+{
+    unsigned int i;
+
+    if (Register == BK4819_REG_02 || Register == BK4819_REG_3F) {
+        return;
+    }
+
+    if (!IsIndirect(Register)) {
+        for (i = 0; i < pCapture->count; i++) {
+            if (pCapture->reg[i] == Register) {
+                pCapture->value[i] = Data;
+                return;
+            }
+        }
+    }
+
+    if (pCapture->count >= BK4819_IMAGE_SIZE) {
+        pCapture->valid = false;
+        return;
+    }
+
+    pCapture->reg[pCapture->count]   = Register;
+    pCapture->value[pCapture->count] = Data;
+    pCapture->count++;
+}
+
+void BK4819_CaptureImage(BK4819_Image_t *pImage)
+{
+    if (pImage) {
+        pImage->count = 0;
+        pImage->valid = true;
+    }
+
+    pCapture = pImage;
+}
+
+void BK4819_ApplyImage(const BK4819_Image_t *pImage)
+{
+    unsigned int i;
+
+    while (BK4819_ReadRegister(BK4819_REG_0C) & 1u) {
+        BK4819_WriteRegister(BK4819_REG_02, 0);
+        SYSTEM_DelayMs(1);
+    }
+    BK4819_WriteRegister(BK4819_REG_3F, 0);
+
+    for (i = 0; i < pImage->count; i++) {
+        const BK4819_REGISTER_t Register = pImage->reg[i];
+        const uint16_t          Data     = pImage->value[i];
+
+        // keep ToggleGpioOut from writing the other VFO's band path back
+        if (Register == BK4819_REG_33)
+            gBK4819_GpioOutState = Data;
+
+        if (!IsIndirect(Register) &&
+            (gShadowKnown[Register / 8] & (1u << (Register % 8))) &&
+            gShadow[Register] == Data)
+        {
+            continue;
+        }
+
+        BK4819_WriteRegister(Register, Data);
+    }
+}
+#endif
+
+#ifdef BK4819_REGISTER_SHADOW
+uint16_t BK4819_GetShadow(BK4819_REGISTER_t Register)
+{
+    return gShadow[Register];
+}
+#endif
+
 void BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data)
 {
+#ifdef BK4819_REGISTER_SHADOW
+    if (Register == BK4819_REG_00) {
+        memset(gShadowKnown, 0, sizeof(gShadowKnown));
+    } else if (Register < 0x80) {
+        gShadow[Register] = Data;
+        gShadowKnown[Register / 8] |= 1u << (Register % 8);
+    }
+#endif
+
+#ifdef ENABLE_FAST_DUAL_WATCH
+    if (pCapture) {
+        CaptureWrite(Register, Data);
+    }
+#endif
+
+    gBK4819_Transactions++;
+
     CS_Release();
     SCL_Reset();
 
@@ -977,6 +1089,11 @@ uint16_t BK4819_GetRSSI(void)
     return BK4819_ReadRegister(BK4819_REG_67) & 0x01FF;
 }
 
+bool BK4819_IsSquelchOpen(void)
+{
+    return (BK4819_ReadRegister(BK4819_REG_0C) >> 1) & 1u;
+}
+
 uint8_t  BK4819_GetGlitchIndicator(void)
 {
     return BK4819_ReadRegister(BK4819_REG_63) & 0x00FF;
@@ -1144,46 +1261,33 @@ void BK4819_PrepareFSKReceive(void)
     BK4819_WriteRegister(BK4819_REG_59, 0x3068);
 }
 
-static void BK4819_PlayRogerNormal(void)
+void BK4819_StartTxTone(void)
 {
-    #if 0
-        const uint32_t tone1_Hz = 500;
-        const uint32_t tone2_Hz = 700;
-    #else
-         
-        const uint32_t tone1_Hz = 1540;
-        const uint32_t tone2_Hz = 1310;
-    #endif
-
-
     BK4819_EnterTxMute();
     BK4819_SetAF(BK4819_AF_MUTE);
-
-    BK4819_WriteRegister(BK4819_REG_70,  
-                                        0xC300
-    );
-
     BK4819_EnableTXLink();
-    SYSTEM_DelayMs(50);
+}
 
-    BK4819_WriteRegister(BK4819_REG_71, scale_freq(tone1_Hz));
+void BK4819_SetTxTone(uint16_t Frequency, uint8_t Level)
+{
+    if (Frequency == 0) {
+        BK4819_EnterTxMute();
+        return;
+    }
 
+    BK4819_WriteRegister(BK4819_REG_70, BK4819_REG_70_ENABLE_TONE1 | ((Level & 0x7f) << BK4819_REG_70_SHIFT_TONE1_TUNING_GAIN));
+    BK4819_WriteRegister(BK4819_REG_71, scale_freq(Frequency));
     BK4819_ExitTxMute();
-    SYSTEM_DelayMs(80);
-    BK4819_EnterTxMute();
-
-    BK4819_WriteRegister(BK4819_REG_71, scale_freq(tone2_Hz));
+}
 
-    BK4819_ExitTxMute();
-    SYSTEM_DelayMs(80);
+void BK4819_StopTxTone(void)
+{
     BK4819_EnterTxMute();
-
     BK4819_WriteRegister(BK4819_REG_70, 0x0000);
-    BK4819_WriteRegister(BK4819_REG_30, 0xC1FE);    
+    BK4819_WriteRegister(BK4819_REG_30, 0xC1FE);
 }
 
-
-void BK4819_PlayRogerMDC(void)
+void BK4819_PrepareRogerMDC(void)
 {
     struct reg_value {
         BK4819_REGISTER_t reg;
@@ -1214,29 +1318,20 @@ void BK4819_PlayRogerMDC(void)
     for (unsigned int i = 0; i < ARRAY_SIZE(FSK_RogerTable); i++) {
         BK4819_WriteRegister(BK4819_REG_5F, FSK_RogerTable[i]);
     }
+}
 
-    SYSTEM_DelayMs(20);
-
-     
+void BK4819_StartRogerMDC(void)
+{
     BK4819_WriteRegister(BK4819_REG_59, 0x0868);
+}
 
-    SYSTEM_DelayMs(180);
-
-     
+void BK4819_StopRogerMDC(void)
+{
     BK4819_WriteRegister(BK4819_REG_59, 0x0068);
     BK4819_WriteRegister(BK4819_REG_70, 0x0000);
     BK4819_WriteRegister(BK4819_REG_58, 0x0000);
 }
 
-void BK4819_PlayRoger(void)
-{
-    if (gEeprom.ROGER == ROGER_MODE_ROGER) {
-        BK4819_PlayRogerNormal();
-    } else if (gEeprom.ROGER == ROGER_MODE_MDC) {
-        BK4819_PlayRogerMDC();
-    }
-}
-
 void BK4819_Enable_AfDac_DiscMode_TxDsp(void)
 {
     BK4819_WriteRegister(BK4819_REG_30, 0x0000);
@@ -35,7 +35,8 @@ static const AddrMapping_t ADDR_MAPPINGS[] = {
     _MK_MAPPING(0x00b000, 0x0f40, 0x0f48),   
     _MK_MAPPING(HOLE_ADDR, 0x0f48, 0x0f50),  
     _MK_MAPPING(0x00e000, 0x0f50, 0x1bd0),   
-    _MK_MAPPING(HOLE_ADDR, 0x1bd0, 0x1c00),  
+    _MK_MAPPING(0x003028, 0x1bd0, 0x1be8),   // FM channels 21..32
+    _MK_MAPPING(HOLE_ADDR, 0x1be8, 0x1c00),  
     _MK_MAPPING(0x00f000, 0x1c00, 0x1d00),   
     _MK_MAPPING(HOLE_ADDR, 0x1d00, 0x1e00),  
     _MK_MAPPING(0x010000, 0x1e00, 0x1f90),   
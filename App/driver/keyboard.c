@@ -5,6 +5,10 @@
 #include "driver/systick.h"
 #include "driver/i2c.h"
 #include "misc.h"
+#ifdef ENABLE_KEYBOARD_SCAN_IRQ
+    #include "py32f071_ll_bus.h"
+    #include "py32f071_ll_tim.h"
+#endif
 
 KEY_Code_t gKeyReading0     = KEY_INVALID;
 KEY_Code_t gKeyReading1     = KEY_INVALID;
@@ -61,6 +65,185 @@ static const KEY_Code_t keyboard[5][4] = {
     }
 };
 
+#ifdef ENABLE_KEYBOARD_SCAN_IRQ
+
+// TIM14 drives one column per tick and samples it on the next, so the
+// rows settle for a whole tick and the matrix is read every 5 ms
+#define TIMx                TIM14
+#define SCAN_RATE_HZ        1000
+#define SCAN_STEPS          5
+#define SCANS_PER_10MS      (SCAN_RATE_HZ / SCAN_STEPS / 100)
+#define OVERRIDE_ACTIVE     0x80000000u
+
+static volatile KEY_Code_t RawKey = KEY_INVALID;
+static volatile uint32_t   OverrideMask;
+
+static KEY_Message_t       EventQueue[16];
+static volatile uint8_t    EventHead;
+static volatile uint8_t    EventTail;
+
+static uint8_t             ScanStep;
+static uint32_t            ScanIdleRows;
+static uint32_t            ScanMask;
+static uint32_t            Pressed;
+static uint8_t             Integrator[SCAN_STEPS * 4];
+static KEY_Code_t          ActiveKey = KEY_INVALID;
+static uint16_t            ActiveScans;
+
+static void PushEvent(KEY_Code_t Key, KEY_Event_t Event)
+{
+    const uint8_t Next = (EventHead + 1) % ARRAY_SIZE(EventQueue);
+
+    if (Next == EventTail)
+        return;
+
+    EventQueue[EventHead].Key   = Key;
+    EventQueue[EventHead].Event = Event;
+    EventHead = Next;
+}
+
+static void ScanComplete(uint32_t Mask)
+{
+    const uint8_t  Threshold = key_debounce_10ms * SCANS_PER_10MS;
+    const uint16_t Delay     = (key_repeat_delay_10ms - key_debounce_10ms) * SCANS_PER_10MS;
+    const uint16_t Repeat    = key_repeat_10ms * SCANS_PER_10MS;
+    KEY_Code_t     Raw       = KEY_INVALID;
+    KEY_Code_t     Key       = KEY_INVALID;
+
+    if (OverrideMask & OVERRIDE_ACTIVE)
+        Mask = OverrideMask & ~OVERRIDE_ACTIVE;
+
+    for (unsigned int n = 0; n < ARRAY_SIZE(Integrator); n++)
+    {
+        const uint32_t Bit = 1u << n;
+
+        if (Mask & Bit)
+        {
+            if (Integrator[n] < Threshold && ++Integrator[n] == Threshold)
+                Pressed |= Bit;
+            if (Raw == KEY_INVALID)
+                Raw = keyboard[n / 4][n % 4];
+        }
+        else if (Integrator[n] > 0 && --Integrator[n] == 0)
+            Pressed &= ~Bit;
+
+        if (Key == KEY_INVALID && (Pressed & Bit))
+            Key = keyboard[n / 4][n % 4];
+    }
+
+    RawKey = Raw;
+
+    if (Key != ActiveKey)
+    {
+        if (ActiveKey != KEY_INVALID)
+            PushEvent(ActiveKey, KEY_EVENT_RELEASE);
+        if (Key != KEY_INVALID)
+            PushEvent(Key, KEY_EVENT_PRESS);
+        ActiveKey   = Key;
+        ActiveScans = 0;
+        return;
+    }
+
+    if (Key == KEY_INVALID || ++ActiveScans < Delay)
+        return;
+
+    if (ActiveScans == Delay)
+    {
+        PushEvent(Key, KEY_EVENT_HOLD);
+        return;
+    }
+
+    if (ActiveScans < Delay + Repeat)
+        return;
+
+    ActiveScans = Delay;
+
+    // repeats are not queued behind other events, a stalled loop sees one
+    if ((Key == KEY_UP || Key == KEY_DOWN) && EventHead == EventTail)
+        PushEvent(Key, KEY_EVENT_REPEAT);
+}
+
+void TIM14_IRQHandler(void)
+{
+    LL_TIM_ClearFlag_UPDATE(TIMx);
+
+    // side keys pull their rows low with no column driven
+    uint32_t Rows = ~read_rows() & PIN_MASK_ROWS;
+    if (ScanStep == 0)
+        ScanIdleRows = Rows;
+    else
+        Rows &= ~ScanIdleRows;
+
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        if (Rows & PIN_MASK_ROW(i))
+            ScanMask |= 1u << (ScanStep * 4 + i);
+    }
+
+    if (++ScanStep == SCAN_STEPS)
+    {
+        ScanStep = 0;
+        ScanComplete(ScanMask);
+        ScanMask = 0;
+    }
+
+    GPIO_SetOutputPin(PIN_COLS);
+    if (ScanStep > 0)
+        GPIO_ResetOutputPin(PIN_COL(ScanStep - 1));
+}
+
+void KEYBOARD_Init(void)
+{
+    LL_APB1_GRP2_EnableClock(LL_APB1_GRP2_PERIPH_TIM14);
+
+    GPIO_SetOutputPin(PIN_COLS);
+
+    LL_TIM_SetPrescaler(TIMx, SystemCoreClock / 1000000 - 1);
+    LL_TIM_SetAutoReload(TIMx, 1000000 / SCAN_RATE_HZ - 1);
+    LL_TIM_EnableIT_UPDATE(TIMx);
+
+    NVIC_SetPriority(TIM14_IRQn, 2);
+    NVIC_EnableIRQ(TIM14_IRQn);
+
+    LL_TIM_EnableCounter(TIMx);
+}
+
+bool KEYBOARD_GetEvent(KEY_Message_t *pMessage)
+{
+    if (EventTail == EventHead)
+        return false;
+
+    *pMessage = EventQueue[EventTail];
+    EventTail = (EventTail + 1) % ARRAY_SIZE(EventQueue);
+    return true;
+}
+
+void KEYBOARD_SetOverride(bool bOverride, KEY_Code_t Key)
+{
+    uint32_t Mask = 0;
+
+    for (unsigned int n = 0; Key != KEY_INVALID && n < ARRAY_SIZE(Integrator); n++)
+    {
+        if (keyboard[n / 4][n % 4] == Key)
+        {
+            Mask = 1u << n;
+            break;
+        }
+    }
+
+    OverrideMask = bOverride ? (Mask | OVERRIDE_ACTIVE) : 0;
+}
+
+// Loops that poll the keypad themselves own it, so whatever the event
+// queue collected meanwhile is stale by the time the main loop resumes
+KEY_Code_t KEYBOARD_Poll(void)
+{
+    EventTail = EventHead;
+    return RawKey;
+}
+
+#else
+
 KEY_Code_t KEYBOARD_Poll(void)
 {
     KEY_Code_t Key = KEY_INVALID;
@@ -106,3 +289,5 @@ KEY_Code_t KEYBOARD_Poll(void)
 
     return Key;
 }
+
+#endif
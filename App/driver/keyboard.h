@@ -35,6 +35,25 @@ extern KEY_Code_t gKeyReading1;
 extern uint16_t   gDebounceCounter;
 extern bool       gWasFKeyPressed;
 
+#ifdef ENABLE_KEYBOARD_SCAN_IRQ
+enum KEY_Event_e {
+    KEY_EVENT_PRESS = 0,
+    KEY_EVENT_HOLD,
+    KEY_EVENT_REPEAT,
+    KEY_EVENT_RELEASE
+};
+typedef enum KEY_Event_e KEY_Event_t;
+
+typedef struct {
+    uint8_t Key;
+    uint8_t Event;
+} KEY_Message_t;
+
+void       KEYBOARD_Init(void);
+bool       KEYBOARD_GetEvent(KEY_Message_t *pMessage);
+void       KEYBOARD_SetOverride(bool bOverride, KEY_Code_t Key);
+#endif
+
 KEY_Code_t KEYBOARD_Poll(void);
 
 #endif
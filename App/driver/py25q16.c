@@ -3,6 +3,7 @@
 #include <string.h>
 
 #include "driver/py25q16.h"
+#include "driver/crc.h"
 #include "driver/gpio.h"
 #include "py32f071_ll_bus.h"
 #include "py32f071_ll_system.h"
@@ -22,8 +23,31 @@
 #define SECTOR_SIZE 0x1000
 #define PAGE_SIZE 0x100
 
+#define RECORD_STAMPS 8
+#define RECORD_MAX 0x80
+
+// Fingerprint of a small record known to match flash
+typedef struct
+{
+    uint32_t Address;
+    uint16_t Size;
+    uint16_t Crc;
+    uint16_t Sum;
+} RecordStamp_t;
+
 static uint32_t SectorCacheAddr = 0x1000000;
 static uint8_t SectorCache[SECTOR_SIZE];
+static uint8_t UpdateDepth;
+static bool SectorCacheDirty;
+static bool SectorCacheErase;
+static uint16_t DirtyFrom;
+static uint16_t DirtyTo;
+static RecordStamp_t RecordStamps[RECORD_STAMPS];
+static uint8_t RecordStampNext;
+
+uint16_t gPY25Q16_WritesElided;
+uint16_t gPY25Q16_WritesCommitted;
+uint16_t gPY25Q16_SectorErases;
 static uint32_t BlackHole[1];
 static volatile bool TC_Flag;
 
@@ -274,6 +298,10 @@ static void SectorErase(uint32_t Addr);
 static void SectorProgram(uint32_t Addr, const uint8_t *Buf, uint32_t Size);
 static void PageProgram(uint32_t Addr, const uint8_t *Buf, uint32_t Size);
 static void ReadID(uint8_t *ManufID, uint8_t *MemType, uint8_t *CapacityID);
+static void FlushSectorCache(void);
+static uint16_t RecordSum(const void *pBuffer, uint32_t Size);
+static void DropStamps(uint32_t Address, uint32_t Size);
+static void StampRecord(uint32_t Address, const void *pBuffer, uint32_t Size);
 
 void PY25Q16_Init()
 {
@@ -312,7 +340,14 @@ void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size)
     }
 
     CS_Release();
-    
+
+    // pending patches of an open update win over what is still in flash
+    if (SectorCacheDirty && Address < SectorCacheAddr + SECTOR_SIZE && Address + Size > SectorCacheAddr)
+    {
+        uint32_t From = Address > SectorCacheAddr ? Address : SectorCacheAddr;
+        uint32_t To = Address + Size < SectorCacheAddr + SECTOR_SIZE ? Address + Size : SectorCacheAddr + SECTOR_SIZE;
+        memcpy((uint8_t *)pBuffer + (From - Address), SectorCache + (From - SectorCacheAddr), To - From);
+    }
 }
 
 
@@ -321,6 +356,26 @@ void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, b
 #ifdef DEBUG
     printf("spi flash write: %06x %ld %d\n", Address, Size, Append);
 #endif
+    if (Size <= RECORD_MAX)
+    {
+        for (uint32_t i = 0; i < RECORD_STAMPS; i++)
+        {
+            const RecordStamp_t *pStamp = &RecordStamps[i];
+            if (pStamp->Size == Size && pStamp->Address == Address &&
+                pStamp->Sum == RecordSum(pBuffer, Size) &&
+                pStamp->Crc == CRC_Calculate(pBuffer, Size))
+            {
+                gPY25Q16_WritesElided++;
+                return;
+            }
+        }
+    }
+
+    const uint32_t RecordAddr = Address;
+    const uint32_t RecordSize = Size;
+    const void *pRecord = pBuffer;
+    bool Committed = false;
+
     uint32_t SecIndex = Address / SECTOR_SIZE;
     uint32_t SecAddr = SecIndex * SECTOR_SIZE;
     uint32_t SecOffset = Address % SECTOR_SIZE;
@@ -335,12 +390,14 @@ void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, b
 
         if (SecAddr != SectorCacheAddr)
         {
+            FlushSectorCache();
             PY25Q16_ReadBuffer(SecAddr, SectorCache, SECTOR_SIZE);
             SectorCacheAddr = SecAddr;
         }
 
         if (0 != memcmp(pBuffer, (char *)SectorCache + SecOffset, SecSize))
         {
+            Committed = true;
             bool Erase = false;
             for (uint32_t i = 0; i < SecSize; i++)
             {
@@ -353,7 +410,16 @@ void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, b
 
             memcpy(SectorCache + SecOffset, pBuffer, SecSize);
 
-            if (Erase)
+            if (UpdateDepth)
+            {
+                if (!SectorCacheDirty || SecOffset < DirtyFrom)
+                    DirtyFrom = SecOffset;
+                if (!SectorCacheDirty || SecOffset + SecSize > DirtyTo)
+                    DirtyTo = SecOffset + SecSize;
+                SectorCacheDirty = true;
+                SectorCacheErase |= Erase;
+            }
+            else if (Erase)
             {
                 SectorErase(SecAddr);
                 if (Append)
@@ -384,6 +450,19 @@ void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, b
         SecOffset = 0;
         SecSize = SECTOR_SIZE;
     }  
+
+    if (Committed)
+    {
+        gPY25Q16_WritesCommitted++;
+    }
+
+    StampRecord(RecordAddr, pRecord, RecordSize);
+}
+
+void PY25Q16_ReadRecord(uint32_t Address, void *pBuffer, uint32_t Size)
+{
+    PY25Q16_ReadBuffer(Address, pBuffer, Size);
+    StampRecord(Address, pBuffer, Size);
 }
 
 
@@ -391,12 +470,105 @@ void PY25Q16_SectorErase(uint32_t Address)
 {
     Address -= (Address % SECTOR_SIZE);
     SectorErase(Address);
+    DropStamps(Address, SECTOR_SIZE);
     if (SectorCacheAddr == Address)
     {
         memset(SectorCache, 0xff, SECTOR_SIZE);
+        SectorCacheDirty = false;
+        SectorCacheErase = false;
+    }
+}
+
+void PY25Q16_BeginUpdate(void)
+{
+    UpdateDepth++;
+}
+
+void PY25Q16_CommitUpdate(void)
+{
+    if (UpdateDepth && --UpdateDepth == 0)
+    {
+        FlushSectorCache();
     }
 }
 
+const uint8_t *PY25Q16_CacheSector(uint32_t Address)
+{
+    const uint32_t SecAddr = Address - (Address % SECTOR_SIZE);
+
+    // a dirty cache of an open update already is the newest view
+    if (SecAddr != SectorCacheAddr || !SectorCacheDirty)
+    {
+        FlushSectorCache();
+        PY25Q16_ReadBuffer(SecAddr, SectorCache, SECTOR_SIZE);
+        SectorCacheAddr = SecAddr;
+    }
+
+    return SectorCache + (Address % SECTOR_SIZE);
+}
+
+static uint16_t RecordSum(const void *pBuffer, uint32_t Size)
+{
+    const uint8_t *pData = (const uint8_t *)pBuffer;
+    uint16_t Sum = 0;
+    for (uint32_t i = 0; i < Size; i++)
+    {
+        Sum = (Sum << 1 | Sum >> 15) + pData[i];
+    }
+    return Sum;
+}
+
+static void DropStamps(uint32_t Address, uint32_t Size)
+{
+    for (uint32_t i = 0; i < RECORD_STAMPS; i++)
+    {
+        RecordStamp_t *pStamp = &RecordStamps[i];
+        if (pStamp->Size && pStamp->Address < Address + Size && Address < pStamp->Address + pStamp->Size)
+        {
+            pStamp->Size = 0;
+        }
+    }
+}
+
+static void StampRecord(uint32_t Address, const void *pBuffer, uint32_t Size)
+{
+    DropStamps(Address, Size);
+
+    if (Size > RECORD_MAX)
+    {
+        return;
+    }
+
+    RecordStamp_t *pStamp = &RecordStamps[RecordStampNext];
+    RecordStampNext = (RecordStampNext + 1) % RECORD_STAMPS;
+
+    pStamp->Address = Address;
+    pStamp->Size = Size;
+    pStamp->Crc = CRC_Calculate(pBuffer, Size);
+    pStamp->Sum = RecordSum(pBuffer, Size);
+}
+
+static void FlushSectorCache(void)
+{
+    if (!SectorCacheDirty)
+    {
+        return;
+    }
+
+    if (SectorCacheErase)
+    {
+        SectorErase(SectorCacheAddr);
+        SectorProgram(SectorCacheAddr, SectorCache, SECTOR_SIZE);
+    }
+    else
+    {
+        SectorProgram(SectorCacheAddr + DirtyFrom, SectorCache + DirtyFrom, DirtyTo - DirtyFrom);
+    }
+
+    SectorCacheDirty = false;
+    SectorCacheErase = false;
+}
+
 
 static inline void WriteAddr(uint32_t Addr)
 {
@@ -466,6 +638,7 @@ static void SectorErase(uint32_t Addr)
 #ifdef DEBUG
     printf("spi flash sector erase: %06x\n", Addr);
 #endif
+    gPY25Q16_SectorErases++;
     WaitWIP();   
     WriteEnable();
     
@@ -6,9 +6,27 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+extern uint16_t gPY25Q16_WritesElided;
+extern uint16_t gPY25Q16_WritesCommitted;
+extern uint16_t gPY25Q16_SectorErases;
+
 void PY25Q16_Init();
 void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size);
 void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, bool Append);
 void PY25Q16_SectorErase(uint32_t Address);
 
+// Reads a small record and remembers its fingerprint: writing the same bytes
+// back to the same address and size is then dropped without touching flash.
+void PY25Q16_ReadRecord(uint32_t Address, void *pBuffer, uint32_t Size);
+
+// Writes between Begin and Commit only patch the sector cache; each touched
+// sector is erased and programmed once, when the batch moves on to another
+// sector or on the outermost Commit. Calls nest.
+void PY25Q16_BeginUpdate(void);
+void PY25Q16_CommitUpdate(void);
+
+// Loads the sector holding Address into the write cache with one read and
+// returns the cached bytes at Address. Valid until the next PY25Q16 call.
+const uint8_t *PY25Q16_CacheSector(uint32_t Address);
+
 #endif
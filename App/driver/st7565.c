@@ -9,6 +9,9 @@
 #include "driver/gpio.h"
 #include "driver/st7565.h"
 #include "driver/system.h"
+#ifdef ENABLE_PROFILER
+    #include "helper/profile.h"
+#endif
 #include "misc.h"
 #include "string.h"
 
@@ -22,6 +25,11 @@ uint8_t gStatusLineOld[LCD_WIDTH];
 uint8_t gFrameBuffer[FRAME_LINES][LCD_WIDTH];
 uint8_t gFrameBufferOld[FRAME_LINES][LCD_WIDTH];
 
+#ifdef ENABLE_FEAT_F4HWN
+uint16_t gST7565_PagesSent;
+uint16_t gST7565_PagesSkipped;
+#endif
+
 static void SPI_Init()
 {
     LL_APB1_GRP2_EnableClock(LL_APB1_GRP2_PERIPH_SPI1);
@@ -112,62 +120,68 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
     CS_Assert();
     DrawLine(Column, Line, pBitmap, Size);
     CS_Release();
+
+#ifdef ENABLE_FEAT_F4HWN
+    // keep the shadow copy in sync with what the panel now shows
+    if (pBitmap != NULL && Line <= FRAME_LINES && Column + Size <= LCD_WIDTH) {
+        uint8_t *pOld = (Line == 0) ? gStatusLineOld : gFrameBufferOld[Line - 1];
+        memcpy(pOld + Column, pBitmap, Size);
+    }
+#endif
 }
 
 
 #ifdef ENABLE_FEAT_F4HWN
 
 
-    static void ST7565_BlitScreen(uint8_t line)
+    static void ST7565_Invalidate(void)
     {
-        CS_Assert();
-        ST7565_WriteByte(0x40);
+        memset(gStatusLineOld, 1, sizeof(gStatusLineOld));
+        memset(gFrameBufferOld, 1, sizeof(gFrameBufferOld));
+    }
 
-        if(line == 0)
-        {
-            DrawLine(0, 0, gStatusLine, LCD_WIDTH);
-        }
-        else if(line <= FRAME_LINES)
-        {
-            DrawLine(0, line, gFrameBuffer[line - 1], LCD_WIDTH);
-        }
-        else
-        {
-            for (line = 1; line <= FRAME_LINES; line++) {
-                DrawLine(0, line, gFrameBuffer[line - 1], LCD_WIDTH);
-            }
+    static bool ST7565_BlitPage(uint8_t line, const uint8_t *pBuffer, uint8_t *pOld)
+    {
+        if (memcmp(pBuffer, pOld, LCD_WIDTH) == 0) {
+            gST7565_PagesSkipped++;
+            return false;
         }
 
-        CS_Release();
+        DrawLine(0, line, pBuffer, LCD_WIDTH);
+        memcpy(pOld, pBuffer, LCD_WIDTH);
+        gST7565_PagesSent++;
+#ifdef ENABLE_PROFILER
+        PROFILE_Blit();
+#endif
+        return true;
     }
 
     void ST7565_BlitFullScreen(void)
     {
-        if(memcmp(gFrameBuffer, gFrameBufferOld, sizeof(gFrameBuffer)) != 0)
-        {
-          ST7565_BlitScreen(8);
-          memcpy(gFrameBufferOld, gFrameBuffer, sizeof(gFrameBufferOld));
+        CS_Assert();
+        ST7565_WriteByte(0x40);
+
+        for (unsigned line = 0; line < FRAME_LINES; line++) {
+            ST7565_BlitPage(line + 1, gFrameBuffer[line], gFrameBufferOld[line]);
         }
+
+        CS_Release();
     }
 
     void ST7565_BlitLine(unsigned line)
     {
-        if(memcmp(gFrameBuffer, gFrameBufferOld, sizeof(gFrameBuffer)) != 0)
-        {
-          ST7565_BlitScreen(line + 1);
-          memcpy(gFrameBufferOld, gFrameBuffer, sizeof(gFrameBufferOld));
-        }
-        
+        CS_Assert();
+        ST7565_WriteByte(0x40);
+        ST7565_BlitPage(line + 1, gFrameBuffer[line], gFrameBufferOld[line]);
+        CS_Release();
     }
 
     void ST7565_BlitStatusLine(void)
     {
-        if(memcmp(gStatusLine, gStatusLineOld, sizeof(gStatusLine)) != 0)
-        {
-          ST7565_BlitScreen(0);
-          memcpy(gStatusLineOld, gStatusLine, sizeof(gStatusLineOld));
-        }
-        
+        CS_Assert();
+        ST7565_WriteByte(0x40);
+        ST7565_BlitPage(0, gStatusLine, gStatusLineOld);
+        CS_Release();
     }
 #else
     void ST7565_BlitFullScreen(void)
@@ -178,6 +192,9 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
             DrawLine(0, line+1, gFrameBuffer[line], LCD_WIDTH);
         }
         CS_Release();
+#ifdef ENABLE_PROFILER
+        PROFILE_Blit();
+#endif
     }
 
     void ST7565_BlitLine(unsigned line)
@@ -186,6 +203,9 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
         ST7565_WriteByte(0x40);     
         DrawLine(0, line+1, gFrameBuffer[line], LCD_WIDTH);
         CS_Release();
+#ifdef ENABLE_PROFILER
+        PROFILE_Blit();
+#endif
     }
 
     void ST7565_BlitStatusLine(void)
@@ -194,6 +214,9 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
         ST7565_WriteByte(0x40);     
         DrawLine(0, 0, gStatusLine, LCD_WIDTH);
         CS_Release();
+#ifdef ENABLE_PROFILER
+        PROFILE_Blit();
+#endif
     }
 #endif
 
@@ -205,6 +228,11 @@ void ST7565_FillScreen(uint8_t value)
         DrawLine(0, i, NULL, value);
     }
     CS_Release();
+
+#ifdef ENABLE_FEAT_F4HWN
+    memset(gStatusLineOld, value, sizeof(gStatusLineOld));
+    memset(gFrameBufferOld, value, sizeof(gFrameBufferOld));
+#endif
 }
 
  
@@ -282,7 +310,7 @@ uint8_t cmds[] = {
             ST7565_Cmd(i);
         }
 
-         
+        ST7565_Invalidate();
     }
     #endif
 
@@ -365,6 +393,10 @@ void ST7565_FixInterfGlitch(void)
 #endif
 
     CS_Release();
+
+#ifdef ENABLE_FEAT_F4HWN
+    ST7565_Invalidate();
+#endif
 }
 
 void ST7565_HardwareReset(void)
@@ -3,27 +3,37 @@
 #ifndef DRIVER_VOICE_H
 #define DRIVER_VOICE_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #define VOICE_BUF_CAP 4
-#define VOICE_BUF_LEN 160
+#define VOICE_BUF_LEN 160   
 
-extern uint16_t gVoiceBuf[VOICE_BUF_CAP][VOICE_BUF_LEN];
-extern uint8_t gVoiceBufReadIndex;
-extern uint8_t gVoiceBufWriteIndex;
-extern uint8_t gVoiceBufLen;
+// clip bytes that fill one DAC half-buffer: 160 A-law bytes or 80 bytes of
+// 4-bit IMA ADPCM
+#define VOICE_SLOT_BYTES(adpcm) ((adpcm) ? VOICE_BUF_LEN / 2 : VOICE_BUF_LEN)
 
-static inline void VOICE_BUF_ForwardReadIndex()
+extern uint8_t          gVoiceBuf[VOICE_BUF_CAP][VOICE_BUF_LEN];
+extern volatile uint8_t gVoiceBufReadIndex;
+extern volatile uint8_t gVoiceBufWriteIndex;
+
+static inline uint8_t VOICE_BUF_Len(void)
+{
+    return (uint8_t)(gVoiceBufWriteIndex - gVoiceBufReadIndex);
+}
+
+static inline uint8_t *VOICE_BUF_WriteSlot(void)
 {
-    gVoiceBufReadIndex = (1 + gVoiceBufReadIndex) % VOICE_BUF_CAP;
+    return gVoiceBuf[gVoiceBufWriteIndex % VOICE_BUF_CAP];
 }
 
-static inline void VOICE_BUF_ForwardWriteIndex()
+static inline void VOICE_BUF_ForwardWriteIndex(void)
 {
-    gVoiceBufWriteIndex = (1 + gVoiceBufWriteIndex) % VOICE_BUF_CAP;
+    gVoiceBufWriteIndex++;
 }
 
 void VOICE_Init();
+void VOICE_Reset(bool bAdpcm);
 void VOICE_Start();
 void VOICE_Stop();
 
@@ -29,6 +29,118 @@ const freq_band_table_t frequencyBandTable[] =
         [BAND6_400MHz]={.lower = 40000000,  .upper = 47000000}
 };
 
+// Band and TX permission for every frequency, as sorted breakpoints: an
+// entry covers [lower, next entry's lower). Mirrors frequencyBandTable,
+// the BK4819 gap and the F_LOCK region plans, keep them in sync.
+
+#define LOCK(mode)  (1u << (mode))
+
+#define TX_DEF      LOCK(F_LOCK_DEF)
+#define TX_FCC      LOCK(F_LOCK_FCC)
+#define TX_CE       LOCK(F_LOCK_CE)
+#define TX_GB       LOCK(F_LOCK_GB)
+#define TX_430      LOCK(F_LOCK_430)
+#define TX_438      LOCK(F_LOCK_438)
+#define TX_NONE     LOCK(F_LOCK_NONE)
+#ifdef ENABLE_FEAT_F4HWN_CA
+    #define TX_CA   LOCK(F_LOCK_CA)
+#else
+    #define TX_CA   0
+#endif
+#ifdef ENABLE_FEAT_F4HWN_PMR
+    #define TX_PMR  LOCK(F_LOCK_PMR)
+#else
+    #define TX_PMR  0
+#endif
+#ifdef ENABLE_FEAT_F4HWN_GMRS_FRS_MURS
+    #define TX_GMRS LOCK(F_LOCK_GMRS_FRS_MURS)
+#else
+    #define TX_GMRS 0
+#endif
+
+// extra settings F_LOCK_DEF needs on top of the lock bit
+enum {
+    TX_COND_NONE = 0,
+    TX_COND_200,
+    TX_COND_350,
+    TX_COND_500
+};
+
+typedef struct {
+    uint32_t lower;
+    uint16_t tx_locks;
+    uint8_t  band:3;
+    uint8_t  in_range:1;
+    uint8_t  tx_condition:4;
+} freq_interval_t;
+
+static_assert(F_LOCK_LEN <= 16);
+
+#define VHF     (TX_DEF | TX_NONE | TX_430 | TX_438)
+#define MURS(f) {f, VHF | TX_GMRS, BAND3_137MHz, 1, 0}, {f + 1, VHF, BAND3_137MHz, 1, 0}
+
+static const freq_interval_t frequencyIntervals[] =
+{
+    {        0, 0,                                          BAND1_50MHz,  0, 0},
+#ifndef ENABLE_WIDE_RX
+    {  5000000, TX_NONE,                                    BAND1_50MHz,  1, 0},
+    {  7600000, 0,                                          BAND1_50MHz,  1, 0},
+#else
+    {BX4819_band1_lower, TX_NONE,                           BAND1_50MHz,  1, 0},
+#endif
+    { 10800000, TX_NONE,                                    BAND2_108MHz, 1, 0},
+    { 13700000, VHF,                                        BAND3_137MHz, 1, 0},
+    { 14400000, VHF | TX_FCC | TX_CE | TX_GB | TX_CA,       BAND3_137MHz, 1, 0},
+    { 14600000, VHF | TX_FCC | TX_GB | TX_CA,               BAND3_137MHz, 1, 0},
+    { 14800000, VHF,                                        BAND3_137MHz, 1, 0},
+    MURS(15182000),
+    MURS(15188000),
+    MURS(15194000),
+    MURS(15457000),
+    MURS(15460000),
+    { 17400000, TX_DEF | TX_NONE,                           BAND4_174MHz, 1, TX_COND_200},
+    { 35000000, TX_DEF | TX_NONE,                           BAND5_350MHz, 1, TX_COND_350},
+    { 40000000, TX_DEF | TX_NONE | TX_430 | TX_438,         BAND6_400MHz, 1, 0},
+    { 42000000, TX_DEF | TX_NONE | TX_430 | TX_438 | TX_FCC, BAND6_400MHz, 1, 0},
+    { 43000000, TX_DEF | TX_NONE | TX_438 | TX_FCC | TX_CE | TX_GB | TX_CA, BAND6_400MHz, 1, 0},
+    { 43800000, TX_DEF | TX_NONE | TX_FCC | TX_CE | TX_GB | TX_CA, BAND6_400MHz, 1, 0},
+    { 44000000, TX_DEF | TX_NONE | TX_FCC | TX_CA,          BAND6_400MHz, 1, 0},
+    { 44600625, TX_DEF | TX_NONE | TX_FCC | TX_CA | TX_PMR, BAND6_400MHz, 1, 0},
+    { 44619376, TX_DEF | TX_NONE | TX_FCC | TX_CA,          BAND6_400MHz, 1, 0},
+    { 45000000, TX_DEF | TX_NONE,                           BAND6_400MHz, 1, 0},
+    { 46255000, TX_DEF | TX_NONE | TX_GMRS,                 BAND6_400MHz, 1, 0},
+    { 46272501, TX_DEF | TX_NONE,                           BAND6_400MHz, 1, 0},
+    { 46755000, TX_DEF | TX_NONE | TX_GMRS,                 BAND6_400MHz, 1, 0},
+    { 46772501, TX_DEF | TX_NONE,                           BAND6_400MHz, 1, 0},
+    { 47000000, TX_DEF | TX_NONE,                           BAND7_470MHz, 1, TX_COND_500},
+#ifndef ENABLE_WIDE_RX
+    { 60000000, TX_DEF,                                     BAND7_470MHz, 1, TX_COND_500},
+    { 60000001, 0,                                          BAND7_470MHz, 0, 0},
+#else
+    { 60000001, TX_NONE,                                    BAND7_470MHz, 1, 0},
+    { 63000000, 0,                                          BAND7_470MHz, 0, 0},
+    { 84000000, TX_NONE,                                    BAND7_470MHz, 1, 0},
+    {BX4819_band2_upper, 0,                                 BAND7_470MHz, 1, 0},
+    {BX4819_band2_upper + 1, 0,                             BAND7_470MHz, 0, 0},
+#endif
+};
+
+static const freq_interval_t *FindInterval(const uint32_t Frequency)
+{
+    unsigned int lo = 0;
+    unsigned int hi = ARRAY_SIZE(frequencyIntervals) - 1;
+
+    while (lo < hi) {
+        const unsigned int mid = (lo + hi + 1) / 2;
+        if (frequencyIntervals[mid].lower <= Frequency)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    return &frequencyIntervals[lo];
+}
+
 #ifdef ENABLE_NOAA
     const uint32_t NoaaFrequencyTable[10] =
     {
@@ -97,11 +209,7 @@ static_assert(ARRAY_SIZE(gStepFrequencyTable) == STEP_N_ELEM);
 
 FREQUENCY_Band_t FREQUENCY_GetBand(uint32_t Frequency)
 {
-    for (int32_t band = BAND_N_ELEM - 1; band >= 0; band--)
-        if (Frequency >= frequencyBandTable[band].lower)
-            return (FREQUENCY_Band_t)band;
-
-    return BAND1_50MHz;
+    return (FREQUENCY_Band_t)FindInterval(Frequency)->band;
 }
 
 uint8_t FREQUENCY_CalculateOutputPower(uint8_t TxpLow, uint8_t TxpMid, uint8_t TxpHigh, int32_t LowerLimit, int32_t Middle, int32_t UpperLimit, int32_t Frequency)
@@ -138,128 +246,43 @@ uint32_t FREQUENCY_RoundToStep(uint32_t freq, uint16_t step)
     return (freq + (step + 1) / 2) / step * step;
 }
 
-int32_t TX_freq_check(const uint32_t Frequency)
-{    
-
-    if (Frequency < frequencyBandTable[0].lower || Frequency > frequencyBandTable[BAND_N_ELEM - 1].upper)
-        return -1;   
-
-    if (Frequency >= BX4819_band1.upper && Frequency < BX4819_band2.lower)
-        return -1;   
-
-    switch (gSetting_F_LOCK)
+static bool TxConditionMet(const uint8_t condition)
+{
+    switch (condition)
     {
-        case F_LOCK_DEF:
-            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < frequencyBandTable[BAND3_137MHz].upper)
-                return 0;
-            if (Frequency >= frequencyBandTable[BAND4_174MHz].lower && Frequency < frequencyBandTable[BAND4_174MHz].upper)
-            #ifndef ENABLE_FEAT_F4HWN
-                if (gSetting_200TX)
-            #endif
-                    return 0;
-            if (Frequency >= frequencyBandTable[BAND5_350MHz].lower && Frequency < frequencyBandTable[BAND5_350MHz].upper)
-            #ifndef ENABLE_FEAT_F4HWN
-                if (gSetting_350TX && gSetting_350EN)
-            #else
-                if (gSetting_350EN)                
-            #endif
-                    return 0;
-            if (Frequency >= frequencyBandTable[BAND6_400MHz].lower && Frequency < frequencyBandTable[BAND6_400MHz].upper)
-                return 0;
-            if (Frequency >= frequencyBandTable[BAND7_470MHz].lower && Frequency <= 60000000)
-            #ifndef ENABLE_FEAT_F4HWN
-                if (gSetting_500TX)
-            #endif
-                    return 0;
-            break;
-
-        case F_LOCK_FCC:
-            if (Frequency >= 14400000 && Frequency < 14800000)
-                return 0;
-            if (Frequency >= 42000000 && Frequency < 45000000)
-                return 0;
-            break;
-
-        case F_LOCK_CE:
-            if (Frequency >= 14400000 && Frequency < 14600000)
-                return 0;
-            if (Frequency >= 43000000 && Frequency < 44000000)
-                return 0;
-            break;
-
-        case F_LOCK_GB:
-            if (Frequency >= 14400000 && Frequency < 14800000)
-                return 0;
-            if (Frequency >= 43000000 && Frequency < 44000000)
-                return 0;
-            break;
-
-        case F_LOCK_430:
-            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < 17400000)
-                return 0;
-            if (Frequency >= 40000000 && Frequency < 43000000)
-                return 0;
-            break;
-
-        case F_LOCK_438:
-            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < 17400000)
-                return 0;
-            if (Frequency >= 40000000 && Frequency < 43800000)
-                return 0;
-            break;
-
-#ifdef ENABLE_FEAT_F4HWN_PMR
-        case F_LOCK_PMR:
-            if (Frequency >= 44600625 && Frequency <= 44619375)
-                return 0;
-            break;
-#endif
-
-#ifdef ENABLE_FEAT_F4HWN_GMRS_FRS_MURS
-        case F_LOCK_GMRS_FRS_MURS:
-             
-            if ((Frequency >= 46255000 && Frequency <= 46272500) ||
-                (Frequency >= 46755000 && Frequency <= 46772500))  
-                return 0;
-            if (Frequency == 15182000 || 
-                Frequency == 15188000 || 
-                Frequency == 15194000 || 
-                Frequency == 15457000 || 
-                Frequency == 15460000)  
-                return 0;
-            break;
-#endif
-
-#ifdef ENABLE_FEAT_F4HWN_CA 
-        case F_LOCK_CA:
-            if (Frequency >= 14400000 && Frequency < 14800000)
-                return 0;
-            if (Frequency >= 43000000 && Frequency < 45000000)
-                return 0;
-            break;
-#endif
-
-        case F_LOCK_ALL:
-            break;
-
-        case F_LOCK_NONE:
-            for (uint32_t i = 0; i < ARRAY_SIZE(frequencyBandTable); i++)
-                if (Frequency >= frequencyBandTable[i].lower && Frequency < frequencyBandTable[i].upper)
-                    return 0;
-            break;
+        #ifndef ENABLE_FEAT_F4HWN
+        case TX_COND_200:
+            return gSetting_200TX;
+        case TX_COND_350:
+            return gSetting_350TX && gSetting_350EN;
+        case TX_COND_500:
+            return gSetting_500TX;
+        #else
+        case TX_COND_350:
+            return gSetting_350EN;
+        #endif
+        default:
+            return true;
     }
-
-    return -1;
 }
 
-int32_t RX_freq_check(const uint32_t Frequency)
-{    
+int32_t TX_freq_check(const uint32_t Frequency)
+{
+    const freq_interval_t *pInterval = FindInterval(Frequency);
+
+    if (!pInterval->in_range || gSetting_F_LOCK >= F_LOCK_LEN)
+        return -1;
 
-    if (Frequency < frequencyBandTable[0].lower || Frequency > frequencyBandTable[BAND_N_ELEM - 1].upper)
+    if (!(pInterval->tx_locks & LOCK(gSetting_F_LOCK)))
         return -1;
 
-    if (Frequency >= BX4819_band1.upper && Frequency < BX4819_band2.lower)
+    if (gSetting_F_LOCK == F_LOCK_DEF && !TxConditionMet(pInterval->tx_condition))
         return -1;
 
-    return 0;    
+    return 0;
+}
+
+int32_t RX_freq_check(const uint32_t Frequency)
+{
+    return FindInterval(Frequency)->in_range ? 0 : -1;
 }
@@ -19,6 +19,7 @@
 #include "frequencies.h"
 #include "functions.h"
 #include "helper/battery.h"
+#include "helper/powersave.h"
 #include "misc.h"
 #include "radio.h"
 #include "settings.h"
@@ -103,18 +104,7 @@ void FUNCTION_Foreground(const FUNCTION_Type_t PreviousFunction)
 }
 
 void FUNCTION_PowerSave() {
-    #ifdef ENABLE_FEAT_F4HWN_SLEEP
-        if(gWakeUp)
-        {
-            gPowerSave_10ms = gEeprom.BATTERY_SAVE * 200;  
-        }
-        else
-        {
-            gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
-        }
-    #else
-        gPowerSave_10ms = gEeprom.BATTERY_SAVE * 10;
-    #endif
+    gPowerSave_10ms = POWERSAVE_StartSleep_10ms();
     gPowerSaveCountdownExpired = false;
 
     gRxIdleMode = true;
@@ -155,18 +145,7 @@ void FUNCTION_Transmit()
     {
         GUI_DisplayScreen();
 
-        AUDIO_AudioPathOff();
-
-        SYSTEM_DelayMs(20);
-        BK4819_PlayTone(500, 0);
-        SYSTEM_DelayMs(2);
-
-        AUDIO_AudioPathOn();
-
-        gEnableSpeaker = true;
-
-        SYSTEM_DelayMs(60);
-        BK4819_ExitTxMute();
+        AUDIO_PlayAlarmTone();
 
         gAlarmToneCounter = 0;
         return;
@@ -228,6 +207,10 @@ void FUNCTION_Select(FUNCTION_Type_t Function)
     const FUNCTION_Type_t PreviousFunction = gCurrentFunction;
     const bool bWasPowerSave = PreviousFunction == FUNCTION_POWER_SAVE;
 
+    // a cut short roger still runs its end of transmission hook, and it
+    // has to do so before the new function starts setting up the chip
+    AUDIO_StopTone(Function == FUNCTION_FOREGROUND);
+
     gCurrentFunction = Function;
 
     if (bWasPowerSave && Function != FUNCTION_POWER_SAVE) {
@@ -7,6 +7,7 @@
 #include "driver/st7565.h"
 #include "functions.h"
 #include "misc.h"
+#include "radio.h"
 #include "settings.h"
 #include "ui/battery.h"
 #include "ui/menu.h"
@@ -36,6 +37,38 @@ const uint16_t    lowBatteryPeriod = 30;
 
 volatile uint16_t gPowerSave_10ms;
 
+#ifdef ENABLE_BATTERY_ESTIMATOR
+uint16_t          gBatteryLoad_mA;
+uint16_t          gBatteryRemaining_mAh;
+uint16_t          gBatteryTxSag;
+
+// filtered ADC reading in 1/16 LSB, load in 1/64 mA, charge in mA * 500ms
+static uint32_t   batteryFiltered;
+static uint32_t   loadFiltered;
+static int32_t    batteryCharge;
+
+static const uint16_t BatteryCapacity_mAh[] = {
+    [BATTERY_TYPE_1600_MAH] = 1600,
+    [BATTERY_TYPE_2200_MAH] = 2200,
+    [BATTERY_TYPE_3500_MAH] = 3500,
+    [BATTERY_TYPE_1500_MAH] = 1500,
+    [BATTERY_TYPE_2500_MAH] = 2500,
+};
+
+static const uint16_t TxCurrent_mA[] = {
+    [OUTPUT_POWER_USER] = 1000,
+    [OUTPUT_POWER_LOW1] = 300,
+    [OUTPUT_POWER_LOW2] = 400,
+    [OUTPUT_POWER_LOW3] = 500,
+    [OUTPUT_POWER_LOW4] = 600,
+    [OUTPUT_POWER_LOW5] = 700,
+    [OUTPUT_POWER_MID]  = 1000,
+    [OUTPUT_POWER_HIGH] = 1500,
+};
+
+#define CHARGE_PER_MAH  (3600 * 2)
+#endif
+
 const uint16_t Voltage2PercentageTable[][7][2] = {
     [BATTERY_TYPE_1600_MAH] = {
         {828, 100},
@@ -107,10 +140,110 @@ unsigned int BATTERY_VoltsToPercent(const unsigned int voltage_10mV)
     return 0;
 }
 
+#ifdef ENABLE_BATTERY_ESTIMATOR
+static uint16_t BATTERY_Filter(uint16_t average)
+{
+    uint32_t sample = gBatteryVoltages[(gBatteryVoltageIndex - 1) & 3];
+
+    if (batteryFiltered == 0) {
+        batteryFiltered = (uint32_t)average << 4;
+        return average;
+    }
+
+    if (gCurrentFunction == FUNCTION_TRANSMIT) {
+        // learn how far the pack sags under PA load and add it back
+        const int32_t sag = (int32_t)(batteryFiltered >> 4) - (int32_t)sample;
+        if (sag > 0)
+            gBatteryTxSag += (sag - (int32_t)gBatteryTxSag) / 4;
+        sample += gBatteryTxSag;
+    }
+
+    batteryFiltered += (int32_t)((sample << 4) - batteryFiltered) / 8;
+
+    return batteryFiltered >> 4;
+}
+
+static uint16_t BATTERY_LoadCurrent_mA(void)
+{
+    uint16_t current;
+
+    switch (gCurrentFunction) {
+        case FUNCTION_TRANSMIT:
+            current = TxCurrent_mA[gCurrentVfo->OUTPUT_POWER % ARRAY_SIZE(TxCurrent_mA)];
+            break;
+        case FUNCTION_MONITOR:
+        case FUNCTION_RECEIVE:
+            current = 150;
+            break;
+        case FUNCTION_POWER_SAVE:
+            current = 25;
+            break;
+        default:
+            current = 60;
+            break;
+    }
+
+    if (BACKLIGHT_IsOn())
+        current += 20;
+
+    return current;
+}
+
+static void BATTERY_Count(void)
+{
+    const uint16_t load = BATTERY_LoadCurrent_mA();
+
+    if (loadFiltered == 0)
+        loadFiltered = (uint32_t)load << 6;
+    else
+        loadFiltered += load - (loadFiltered >> 6);
+
+    gBatteryLoad_mA = loadFiltered >> 6;
+
+    if (gChargingWithTypeC)
+        return;
+
+    batteryCharge -= load;
+    if (batteryCharge < 0)
+        batteryCharge = 0;
+
+    gBatteryRemaining_mAh = batteryCharge / CHARGE_PER_MAH;
+}
+
+static void BATTERY_Anchor(void)
+{
+    if (gEeprom.BATTERY_TYPE >= ARRAY_SIZE(BatteryCapacity_mAh))
+        return;
+
+    // pull the coulomb count towards the voltage curve while the pack is at rest
+    const int32_t capacity = (int32_t)BatteryCapacity_mAh[gEeprom.BATTERY_TYPE] * CHARGE_PER_MAH;
+    const int32_t estimate = capacity / 100 * BATTERY_VoltsToPercent(gBatteryVoltageAverage);
+
+    if (batteryCharge == 0 || gChargingWithTypeC)
+        batteryCharge = estimate;
+    else if (gCurrentFunction == FUNCTION_FOREGROUND || gCurrentFunction == FUNCTION_POWER_SAVE)
+        batteryCharge += (estimate - batteryCharge) / 32;
+
+    gBatteryRemaining_mAh = batteryCharge / CHARGE_PER_MAH;
+}
+
+uint16_t BATTERY_GetRuntime_min(void)
+{
+    if (gBatteryLoad_mA == 0)
+        return 0;
+
+    return MIN((uint32_t)gBatteryRemaining_mAh * 60 / gBatteryLoad_mA, 5999u);
+}
+#endif
+
 void BATTERY_GetReadings(const bool bDisplayBatteryLevel)
 {
     const uint8_t  PreviousBatteryLevel = gBatteryDisplayLevel;
+#ifdef ENABLE_BATTERY_ESTIMATOR
+    const uint16_t Voltage              = BATTERY_Filter((gBatteryVoltages[0] + gBatteryVoltages[1] + gBatteryVoltages[2] + gBatteryVoltages[3]) / 4);
+#else
     const uint16_t Voltage              = (gBatteryVoltages[0] + gBatteryVoltages[1] + gBatteryVoltages[2] + gBatteryVoltages[3]) / 4;
+#endif
 
     gBatteryVoltageAverage = (Voltage * 760) / gBatteryCalibration[3];
 
@@ -140,6 +273,10 @@ void BATTERY_GetReadings(const bool bDisplayBatteryLevel)
     if ((gScreenToDisplay == DISPLAY_MENU) && UI_MENU_GetCurrentMenuId() == MENU_VOL)
         gUpdateDisplay = true;
 
+#ifdef ENABLE_BATTERY_ESTIMATOR
+    BATTERY_Anchor();
+#endif
+
     if (gBatteryCurrent < 501)
     {
         if (gChargingWithTypeC)
@@ -187,6 +324,10 @@ void BATTERY_GetReadings(const bool bDisplayBatteryLevel)
 
 void BATTERY_TimeSlice500ms(void)
 {
+#ifdef ENABLE_BATTERY_ESTIMATOR
+    BATTERY_Count();
+#endif
+
     if (!gLowBattery) {
         return;
     }
@@ -30,6 +30,14 @@ typedef enum {
 } BATTERY_Type_t;
 
 
+#ifdef ENABLE_BATTERY_ESTIMATOR
+extern uint16_t          gBatteryLoad_mA;
+extern uint16_t          gBatteryRemaining_mAh;
+extern uint16_t          gBatteryTxSag;
+
+uint16_t BATTERY_GetRuntime_min(void);
+#endif
+
 unsigned int BATTERY_VoltsToPercent(unsigned int voltage_10mV);
 void BATTERY_GetReadings(bool bDisplayBatteryLevel);
 void BATTERY_TimeSlice500ms(void);
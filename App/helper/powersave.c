@@ -0,0 +1,82 @@
+#include "helper/powersave.h"
+#include "misc.h"
+#include "settings.h"
+
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+PowerSaveStats_t  gPowerSaveStats;
+
+static uint16_t   autoSleep_10ms;
+static uint16_t   lastSleep_10ms;
+static bool       firstWindow;
+static bool       heard;
+#endif
+
+uint16_t POWERSAVE_GetSleep_10ms(void)
+{
+    uint16_t period = gEeprom.BATTERY_SAVE * 10;
+
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+    // nothing has set the window before the first sleep or activity
+    if (gEeprom.BATTERY_SAVE == BATTERY_SAVE_AUTO)
+        period = MAX(autoSleep_10ms, power_save_auto_min_10ms);
+#endif
+
+#ifdef ENABLE_FEAT_F4HWN_SLEEP
+    if (gWakeUp)
+        period *= 20;
+#endif
+
+    return period;
+}
+
+uint16_t POWERSAVE_StartSleep_10ms(void)
+{
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+    if (gEeprom.BATTERY_SAVE == BATTERY_SAVE_AUTO) {
+        if (autoSleep_10ms < power_save_auto_min_10ms)
+            autoSleep_10ms = power_save_auto_min_10ms;
+
+        // lengthen the sleep window by one tick per quiet listen window,
+        // never beyond the 1:5 ratio so wake latency stays bounded
+        if (!heard && autoSleep_10ms < power_save_auto_max_10ms)
+            autoSleep_10ms++;
+    }
+
+    if (!heard && lastSleep_10ms != 0)
+        gPowerSaveStats.quietWakes++;
+
+    heard       = false;
+    firstWindow = false;
+
+    lastSleep_10ms = POWERSAVE_GetSleep_10ms();
+
+    gPowerSaveStats.sleepCycles++;
+    gPowerSaveStats.sleep_10ms += lastSleep_10ms;
+
+    return lastSleep_10ms;
+#else
+    return POWERSAVE_GetSleep_10ms();
+#endif
+}
+
+void POWERSAVE_Wake(void)
+{
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+    firstWindow = true;
+#endif
+}
+
+void POWERSAVE_Activity(void)
+{
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+    if (firstWindow) {
+        gPowerSaveStats.activeWakes++;
+        if (lastSleep_10ms > gPowerSaveStats.missedRisk_10ms)
+            gPowerSaveStats.missedRisk_10ms = lastSleep_10ms;
+        firstWindow = false;
+    }
+
+    heard          = true;
+    autoSleep_10ms = power_save_auto_min_10ms;
+#endif
+}
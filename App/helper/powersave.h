@@ -0,0 +1,24 @@
+#ifndef HELPER_POWERSAVE_H
+#define HELPER_POWERSAVE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+typedef struct {
+    uint16_t sleepCycles;
+    uint16_t quietWakes;
+    uint16_t activeWakes;        // squelch opened in the first listen window after a sleep
+    uint16_t missedRisk_10ms;    // worst case of preamble slept through on activeWakes
+    uint32_t sleep_10ms;
+} PowerSaveStats_t;
+
+extern PowerSaveStats_t gPowerSaveStats;
+#endif
+
+uint16_t POWERSAVE_GetSleep_10ms(void);
+uint16_t POWERSAVE_StartSleep_10ms(void);
+void     POWERSAVE_Wake(void);
+void     POWERSAVE_Activity(void);
+
+#endif
@@ -0,0 +1,131 @@
+#include <string.h>
+
+#include "py32f0xx.h"
+#include "helper/profile.h"
+#include "scheduler.h"
+
+PROFILE_t  gProfile;
+
+const char gProfileTaskNames[PROFILE_TASK_N][6] = {
+    [PROFILE_SLICE_10MS]  = "SLICE",
+    [PROFILE_DISPLAY]     = "GUI",
+    [PROFILE_RADIO_IRQ]   = "RADIO",
+    [PROFILE_KEYS]        = "KEYS",
+    [PROFILE_SCANNER]     = "SCAN",
+    [PROFILE_SLICE_500MS] = "500MS",
+    [PROFILE_DUAL_WATCH]  = "DWSWP",
+    [PROFILE_BOOT_SETTINGS] = "BTSET",
+    [PROFILE_BOOT_CALIB]    = "BTCAL",
+    [PROFILE_BOOT_RADIO]    = "BTRAD",
+    [PROFILE_BOOT_NAMES]    = "BTNAM",
+};
+
+static uint32_t lastSliceTick;
+static uint32_t keyStart;
+static uint32_t *pKeyLatency;
+
+// CPU cycles since boot (wraps), the M0+ has no DWT cycle counter so
+// the SysTick period count is combined with the current down-counter
+uint32_t PROFILE_Now(void)
+{
+    uint32_t ticks;
+    uint32_t val;
+
+    do {
+        ticks = gGlobalSysTickCounter;
+        val   = SysTick->VAL;
+    } while (ticks != gGlobalSysTickCounter);
+
+    return ticks * (SysTick->LOAD + 1) + (SysTick->LOAD - val);
+}
+
+void PROFILE_Record(PROFILE_Task_t task, uint32_t start)
+{
+    PROFILE_Stats_t *pStats         = &gProfile.task[task];
+    const uint32_t   cycles_per_us  = (SysTick->LOAD + 1) / 10000;
+    const uint32_t   slice_us       = 10000;
+    uint32_t         elapsed_us     = (PROFILE_Now() - start) / cycles_per_us;
+
+    if (elapsed_us > slice_us)
+        pStats->overruns++;
+
+    if (elapsed_us > UINT16_MAX)
+        elapsed_us = UINT16_MAX;
+
+    pStats->history_us[pStats->head] = elapsed_us;
+    pStats->head = (pStats->head + 1) % PROFILE_HISTORY;
+    if (pStats->samples < PROFILE_HISTORY)
+        pStats->samples++;
+
+    if (pStats->min_us == 0 || elapsed_us < pStats->min_us)
+        pStats->min_us = elapsed_us ? elapsed_us : 1;
+    if (elapsed_us > pStats->max_us)
+        pStats->max_us = elapsed_us;
+
+    if (task == PROFILE_SLICE_10MS) {
+        const uint32_t ticks = gGlobalSysTickCounter;
+
+        if (lastSliceTick != 0 && ticks - lastSliceTick > 1)
+            gProfile.missedSlices += ticks - lastSliceTick - 1;
+        lastSliceTick = ticks;
+    }
+}
+
+uint16_t PROFILE_GetAverage_us(PROFILE_Task_t task)
+{
+    const PROFILE_Stats_t *pStats = &gProfile.task[task];
+    uint32_t               sum    = 0;
+
+    if (pStats->samples == 0)
+        return 0;
+
+    for (unsigned int i = 0; i < pStats->samples; i++)
+        sum += pStats->history_us[i];
+
+    return sum / pStats->samples;
+}
+
+void PROFILE_Reset(void)
+{
+    memset(&gProfile, 0, sizeof(gProfile));
+    lastSliceTick = 0;
+    pKeyLatency   = NULL;
+}
+
+// a key down starts a new step, the key up of the same step is timed as well
+void PROFILE_KeyEvent(uint8_t key, bool bKeyPressed, bool bKeyHeld)
+{
+    PROFILE_KeyStep_t *pStep = &gProfile.key;
+
+    if (bKeyHeld)
+        return;
+
+    if (bKeyPressed) {
+        pStep->tick       = gGlobalSysTickCounter;
+        pStep->press_us   = UINT32_MAX;
+        pStep->release_us = UINT32_MAX;
+        pStep->key        = key;
+        pStep->seq++;
+        pKeyLatency = &pStep->press_us;
+    }
+    else if (key == pStep->key) {
+        pKeyLatency = &pStep->release_us;
+    }
+    else {
+        return;
+    }
+
+    keyStart = PROFILE_Now();
+}
+
+void PROFILE_Blit(void)
+{
+    if (pKeyLatency == NULL)
+        return;
+
+    const uint32_t cycles_per_us = (SysTick->LOAD + 1) / 10000;
+    const uint32_t elapsed_us    = (PROFILE_Now() - keyStart) / cycles_per_us;
+
+    *pKeyLatency = (elapsed_us < UINT32_MAX) ? elapsed_us : UINT32_MAX - 1;
+    pKeyLatency  = NULL;
+}
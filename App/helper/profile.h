@@ -0,0 +1,67 @@
+#ifndef HELPER_PROFILE_H
+#define HELPER_PROFILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+enum PROFILE_Task_t {
+    PROFILE_SLICE_10MS = 0,
+    PROFILE_DISPLAY,
+    PROFILE_RADIO_IRQ,
+    PROFILE_KEYS,
+    PROFILE_SCANNER,
+    PROFILE_SLICE_500MS,
+    PROFILE_DUAL_WATCH,
+    PROFILE_BOOT_SETTINGS,      // one-shot power-on phases
+    PROFILE_BOOT_CALIB,
+    PROFILE_BOOT_RADIO,
+    PROFILE_BOOT_NAMES,
+    PROFILE_TASK_N
+};
+
+typedef enum PROFILE_Task_t PROFILE_Task_t;
+
+#ifdef ENABLE_PROFILER
+#define PROFILE_HISTORY 8
+
+typedef struct {
+    uint16_t history_us[PROFILE_HISTORY];
+    uint8_t  head;
+    uint8_t  samples;
+    uint16_t min_us;
+    uint16_t max_us;
+    uint16_t overruns;          // runs longer than one 10 ms slice
+} PROFILE_Stats_t;
+
+typedef struct {
+    uint32_t tick;              // SysTick count at key down
+    uint32_t press_us;          // key down to the next LCD page update, UINT32_MAX if none yet
+    uint32_t release_us;        // key up to the next LCD page update, UINT32_MAX if none yet
+    uint8_t  key;
+    uint8_t  seq;               // counts key downs
+} PROFILE_KeyStep_t;
+
+typedef struct {
+    PROFILE_Stats_t   task[PROFILE_TASK_N];
+    uint16_t          missedSlices;   // SysTick periods that elapsed without a 10 ms slice
+    PROFILE_KeyStep_t key;            // latest key press
+} PROFILE_t;
+
+extern PROFILE_t  gProfile;
+extern const char gProfileTaskNames[PROFILE_TASK_N][6];
+
+uint32_t PROFILE_Now(void);
+void     PROFILE_Record(PROFILE_Task_t task, uint32_t start);
+uint16_t PROFILE_GetAverage_us(PROFILE_Task_t task);
+void     PROFILE_Reset(void);
+void     PROFILE_KeyEvent(uint8_t key, bool bKeyPressed, bool bKeyHeld);
+void     PROFILE_Blit(void);
+
+#define PROFILE_BEGIN(task)   const uint32_t profile_##task = PROFILE_Now()
+#define PROFILE_END(task)     PROFILE_Record(task, profile_##task)
+#else
+#define PROFILE_BEGIN(task)
+#define PROFILE_END(task)
+#endif
+
+#endif
@@ -38,6 +38,7 @@
 #endif
 #include "helper/battery.h"
 #include "helper/boot.h"
+#include "helper/profile.h"
 
 #include "ui/lock.h"
 #include "ui/welcome.h"
@@ -81,7 +82,19 @@ void Main(void)
 
     BOARD_ADC_GetBatteryInfo(&gBatteryCurrentVoltage, &gBatteryCurrent);
 
+    PROFILE_BEGIN(PROFILE_BOOT_SETTINGS);
     SETTINGS_InitEEPROM();
+    PROFILE_END(PROFILE_BOOT_SETTINGS);
+
+#ifdef ENABLE_DTMF_CALLING
+    DTMF_BuildContactIndex();
+#endif
+
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+    PROFILE_BEGIN(PROFILE_BOOT_NAMES);
+    SETTINGS_BuildChannelNameIndex();
+    PROFILE_END(PROFILE_BOOT_NAMES);
+#endif
 
     #ifdef ENABLE_FEAT_F4HWN
         gDW = gEeprom.DUAL_WATCH;
@@ -89,14 +102,19 @@ void Main(void)
     #endif
 
     SETTINGS_WriteBuildOptions();
+
+    PROFILE_BEGIN(PROFILE_BOOT_CALIB);
     SETTINGS_LoadCalibration();
+    PROFILE_END(PROFILE_BOOT_CALIB);
 
+    PROFILE_BEGIN(PROFILE_BOOT_RADIO);
     RADIO_ConfigureChannel(0, VFO_CONFIGURE_RELOAD);
     RADIO_ConfigureChannel(1, VFO_CONFIGURE_RELOAD);
 
     RADIO_SelectVfos();
 
     RADIO_SetupRegisters(true);
+    PROFILE_END(PROFILE_BOOT_RADIO);
 
     for (unsigned int i = 0; i < ARRAY_SIZE(gBatteryVoltages); i++)
         BOARD_ADC_GetBatteryInfo(&gBatteryVoltages[i], &gBatteryCurrent);
@@ -264,12 +282,15 @@ void Main(void)
 
         if (gNextTimeslice)
         {
-             
+            PROFILE_BEGIN(PROFILE_SLICE_10MS);
             APP_TimeSlice10ms();
+            PROFILE_END(PROFILE_SLICE_10MS);
 
             if (gNextTimeslice_500ms)
             {
+                PROFILE_BEGIN(PROFILE_SLICE_500MS);
                 APP_TimeSlice500ms();
+                PROFILE_END(PROFILE_SLICE_500MS);
             }
         }
     }
@@ -8,6 +8,8 @@
 const uint8_t     fm_radio_countdown_500ms         =  2000 / 500;  
 const uint16_t    fm_play_countdown_scan_10ms      =   100 / 10;   
 const uint16_t    fm_play_countdown_noscan_10ms    =  1200 / 10;   
+const uint16_t    fm_sweep_settle_10ms             =    40 / 10;   
+const uint8_t     fm_sweep_min_rssi                =    10;        
 const uint16_t    fm_restore_countdown_10ms        =  5000 / 10;   
 
 const uint8_t     vfo_state_resume_countdown_500ms =  2500 / 500;  
@@ -49,6 +51,29 @@ const uint8_t     scan_delay_10ms                  =   210 / 10;
 #endif
 const uint16_t    dual_watch_count_toggle_10ms     =   100 / 10;   
 
+#ifdef ENABLE_DTMF_LOG
+    const uint16_t    dtmf_log_gap_10ms                =  1500 / 10;   
+#endif
+
+#ifdef ENABLE_PRIORITY_WATCH
+    const uint16_t    watch_priority_idle_10ms         =   300 / 10;   
+    const uint16_t    watch_priority_rx_10ms           =  2000 / 10;   
+    const uint16_t    watch_priority_dwell_10ms        =    40 / 10;   
+    const uint16_t    watch_priority_hang_10ms         =  3000 / 10;   
+#endif
+
+#ifdef ENABLE_AIRCOPY
+    const uint16_t    aircopy_v2_gap_10ms              =   100 / 10;   
+    const uint16_t    aircopy_v2_turnaround_10ms       =   200 / 10;   
+    const uint16_t    aircopy_v2_report_10ms           =  3000 / 10;   
+#endif
+
+#ifdef ENABLE_AM_FIX__
+    const uint16_t    am_fix_hold_10ms                 =   300 / 10;   
+    const uint16_t    am_fix_decay_10ms                =    50 / 10;   
+    const uint16_t    am_fix_settle_10ms               =    20 / 10;   
+#endif
+
 const uint16_t    scan_pause_delay_in_1_10ms       =  5000 / 10;   
 const uint16_t    scan_pause_delay_in_2_10ms       =   500 / 10;   
 const uint16_t    scan_pause_delay_in_3_10ms       =   200 / 10;   
@@ -61,6 +86,10 @@ const uint16_t    battery_save_count_10ms          = 10000 / 10;
 
 const uint16_t    power_save1_10ms                 =   100 / 10;   
 const uint16_t    power_save2_10ms                 =   200 / 10;   
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+    const uint16_t    power_save_auto_min_10ms         =   100 / 10;   
+    const uint16_t    power_save_auto_max_10ms         =   500 / 10;   
+#endif
 
 #ifdef ENABLE_VOX
     const uint16_t    vox_stop_count_down_10ms         =  1000 / 10;   
@@ -127,6 +156,9 @@ enum BacklightOnRxTx_t gSetting_backlight_on_tx_rx;
 #ifdef ENABLE_AUDIO_BAR
     bool          gSetting_mic_bar;
 #endif
+#ifdef ENABLE_AM_FIX__
+    bool          gSetting_AM_fix = true;
+#endif
 bool              gSetting_live_DTMF_decoder;
 uint8_t           gSetting_battery_text;
 
@@ -215,6 +247,7 @@ bool              gFlagResetVfos;
 bool              gRequestSaveVFO;
 uint8_t           gRequestSaveChannel;
 bool              gRequestSaveSettings;
+uint8_t           gRequestSaveRecords;
 #ifdef ENABLE_FMRADIO
     bool          gRequestSaveFM;
 #endif
@@ -68,6 +68,8 @@ enum BacklightOnRxTx_t {
 extern const uint8_t         fm_radio_countdown_500ms;
 extern const uint16_t        fm_play_countdown_scan_10ms;
 extern const uint16_t        fm_play_countdown_noscan_10ms;
+extern const uint16_t        fm_sweep_settle_10ms;
+extern const uint8_t         fm_sweep_min_rssi;
 extern const uint16_t        fm_restore_countdown_10ms;
 
 extern const uint8_t        vfo_state_resume_countdown_500ms;
@@ -94,6 +96,10 @@ extern const uint16_t        battery_save_count_10ms;
 
 extern const uint16_t        power_save1_10ms;
 extern const uint16_t        power_save2_10ms;
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+    extern const uint16_t    power_save_auto_min_10ms;
+    extern const uint16_t    power_save_auto_max_10ms;
+#endif
 
 #ifdef ENABLE_VOX
     extern const uint16_t    vox_stop_count_down_10ms;
@@ -108,6 +114,25 @@ extern const uint16_t        dual_watch_count_after_rx_10ms;
 extern const uint16_t        dual_watch_count_after_1_10ms;
 extern const uint16_t        dual_watch_count_after_2_10ms;
 extern const uint16_t        dual_watch_count_toggle_10ms;
+#ifdef ENABLE_DTMF_LOG
+    extern const uint16_t    dtmf_log_gap_10ms;
+#endif
+#ifdef ENABLE_PRIORITY_WATCH
+    extern const uint16_t    watch_priority_idle_10ms;
+    extern const uint16_t    watch_priority_rx_10ms;
+    extern const uint16_t    watch_priority_dwell_10ms;
+    extern const uint16_t    watch_priority_hang_10ms;
+#endif
+#ifdef ENABLE_AIRCOPY
+    extern const uint16_t    aircopy_v2_gap_10ms;
+    extern const uint16_t    aircopy_v2_turnaround_10ms;
+    extern const uint16_t    aircopy_v2_report_10ms;
+#endif
+#ifdef ENABLE_AM_FIX__
+    extern const uint16_t    am_fix_hold_10ms;
+    extern const uint16_t    am_fix_decay_10ms;
+    extern const uint16_t    am_fix_settle_10ms;
+#endif
 extern const uint16_t        dual_watch_count_noaa_10ms;
 #ifdef ENABLE_VOX
     extern const uint16_t    dual_watch_count_after_vox_10ms;
@@ -177,6 +202,9 @@ extern enum BacklightOnRxTx_t gSetting_backlight_on_tx_rx;
 #ifdef ENABLE_AUDIO_BAR
     extern bool              gSetting_mic_bar;
 #endif
+#ifdef ENABLE_AM_FIX__
+    extern bool              gSetting_AM_fix;
+#endif
 extern bool                  gSetting_live_DTMF_decoder;
 extern uint8_t               gSetting_battery_text;
 
@@ -280,6 +308,7 @@ extern bool                  gFlagResetVfos;
 extern bool                  gRequestSaveVFO;
 extern uint8_t               gRequestSaveChannel;
 extern bool                  gRequestSaveSettings;
+extern uint8_t               gRequestSaveRecords;    // SETTINGS_RECORD_* to save, less than gRequestSaveSettings
 #ifdef ENABLE_FMRADIO
     extern bool              gRequestSaveFM;
 #endif
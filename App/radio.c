@@ -28,6 +28,11 @@ VFO_Info_t    *gCurrentVfo;
 DCS_CodeType_t gCurrentCodeType;
 VfoState_t     VfoState[2];
 
+#ifdef ENABLE_FAST_DUAL_WATCH
+static BK4819_Image_t gRxImage[2];
+static bool           gKeepRxImages;
+#endif
+
 const char gModulationStr[MODULATION_UKNOWN][4] = {
     [MODULATION_FM]="FM",
     [MODULATION_AM]="AM",
@@ -553,6 +558,19 @@ void RADIO_SetupRegisters(bool switchToForeground)
 {
     BK4819_FilterBandwidth_t Bandwidth = gRxVfo->CHANNEL_BANDWIDTH;
 
+#ifdef ENABLE_FAST_DUAL_WATCH
+    BK4819_Image_t *pImage = &gRxImage[gRxVfo - gEeprom.VfoInfo];
+
+    // a full setup may follow a settings change that also affects the
+    // other VFO, so its image is only trusted when we came from a swap
+    if (!gKeepRxImages) {
+        gRxImage[0].valid = false;
+        gRxImage[1].valid = false;
+    }
+
+    BK4819_CaptureImage(pImage);
+#endif
+
     #ifdef ENABLE_FEAT_F4HWN_NARROWER
         if(Bandwidth == BK4819_FILTER_BW_NARROW && gSetting_set_nfm == 1)
         {
@@ -716,6 +734,12 @@ void RADIO_SetupRegisters(bool switchToForeground)
     BK4819_EnableDTMF();
     InterruptMask |= BK4819_REG_3F_DTMF_5TONE_FOUND;
 
+#ifdef ENABLE_FAST_DUAL_WATCH
+    // AGC writes are gated by RADIO_SetupAGC's own state, keep them out of the image
+    BK4819_CaptureImage(NULL);
+    pImage->interruptMask = InterruptMask;
+#endif
+
     RADIO_SetupAGC(gRxVfo->Modulation == MODULATION_AM, false);
 
     BK4819_WriteRegister(BK4819_REG_3F, InterruptMask);
@@ -726,6 +750,35 @@ void RADIO_SetupRegisters(bool switchToForeground)
         FUNCTION_Select(FUNCTION_FOREGROUND);
 }
 
+void RADIO_SwapRxRegisters(void)
+{
+#ifdef ENABLE_FAST_DUAL_WATCH
+    const BK4819_Image_t *pImage = &gRxImage[gRxVfo - gEeprom.VfoInfo];
+
+    if (pImage->valid
+#ifdef ENABLE_NOAA
+        && !gIsNoaaMode
+#endif
+    ) {
+        AUDIO_AudioPathOff();
+        gEnableSpeaker = false;
+
+        BK4819_ApplyImage(pImage);
+        RADIO_SetupAGC(gRxVfo->Modulation == MODULATION_AM, false);
+        BK4819_WriteRegister(BK4819_REG_3F, pImage->interruptMask);
+
+        FUNCTION_Init();
+        return;
+    }
+
+    gKeepRxImages = true;
+    RADIO_SetupRegisters(false);
+    gKeepRxImages = false;
+#else
+    RADIO_SetupRegisters(false);
+#endif
+}
+
 #ifdef ENABLE_NOAA
      
     void RADIO_ConfigureNOAA(void)
@@ -907,7 +960,16 @@ void RADIO_SetupAGC(bool listeningAM, bool disable)
     if(lastSettings == newSettings)
         return;
     lastSettings = newSettings;
-    
+
+#ifdef ENABLE_AM_FIX__
+    // the AM fix drives REG_13 itself, keep the chip AGC out of its way
+    if (listeningAM && gSetting_AM_fix) {
+        BK4819_SetAGC(false);
+        AM_fix_enable(!disable);
+        return;
+    }
+#endif
+
     BK4819_SetAGC(!disable);
     BK4819_InitAGC(listeningAM);
 
@@ -1063,9 +1125,8 @@ void RADIO_SendCssTail(void)
     SYSTEM_DelayMs(200);
 }
 
-void RADIO_SendEndOfTransmission(void)
+static void FinishEndOfTransmission(void)
 {
-    BK4819_PlayRoger();
     DTMF_SendEndOfTransmission();
 
     if(gEeprom.TAIL_TONE_ELIMINATION)
@@ -1073,6 +1134,13 @@ void RADIO_SendEndOfTransmission(void)
     RADIO_SetupRegisters(false);
 }
 
+void RADIO_SendEndOfTransmission(void)
+{
+    // the roger plays from the tone sequencer, the tail follows once it is done
+    if (!AUDIO_PlayRoger(FinishEndOfTransmission))
+        FinishEndOfTransmission();
+}
+
 void RADIO_PrepareCssTX(void)
 {
     RADIO_PrepareTX();
@@ -140,6 +140,8 @@ void     RADIO_ApplyOffset(VFO_Info_t *pInfo);
 void     RADIO_SelectVfos(void);
  
 void     RADIO_SetupRegisters(bool switchToForeground);
+ 
+void     RADIO_SwapRxRegisters(void);
 #ifdef ENABLE_NOAA
     void RADIO_ConfigureNOAA(void);
 #endif
@@ -5,6 +5,8 @@
 
 #include "py32f0xx.h"
 
+extern volatile uint32_t gGlobalSysTickCounter;
+
 static void inline SCHEDULER_Enable()
 {
     NVIC_EnableIRQ(SysTick_IRQn);
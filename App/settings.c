@@ -28,9 +28,11 @@ EEPROM_Config_t gEeprom = { 0 };
 
 void SETTINGS_InitEEPROM(void)
 {
-    uint8_t Data[16] = {0};
-     
-    PY25Q16_ReadBuffer(0x004000, Data, 8);
+    // each settings sector is read once, the fields are parsed from the copy
+    uint8_t  Buf[0x50] = {0};
+    uint8_t *Data      = Buf;
+
+    PY25Q16_ReadRecord(0x004000, Buf, 16);
     gEeprom.CHAN_1_CALL          = IS_MR_CHANNEL(Data[0]) ? Data[0] : MR_CHANNEL_FIRST;
     gEeprom.SQUELCH_LEVEL        = (Data[1] < 10) ? Data[1] : 1;
     gEeprom.TX_TIMEOUT_TIMER     = (Data[2] > 4 && Data[2] < 180) ? Data[2] : 11;
@@ -46,7 +48,7 @@ void SETTINGS_InitEEPROM(void)
     #endif
     gEeprom.MIC_SENSITIVITY      = (Data[7] <  5) ? Data[7] : 4;
 
-    PY25Q16_ReadBuffer(0x004008, Data, 8);
+    Data = Buf + 0x8;
     gEeprom.BACKLIGHT_MAX         = (Data[0] & 0xF) <= 10 ? (Data[0] & 0xF) : 10;
     gEeprom.BACKLIGHT_MIN         = (Data[0] >> 4) < gEeprom.BACKLIGHT_MAX ? (Data[0] >> 4) : 0;
 #ifdef ENABLE_BLMIN_TMP_OFF
@@ -54,7 +56,7 @@ void SETTINGS_InitEEPROM(void)
 #endif
     gEeprom.CHANNEL_DISPLAY_MODE  = (Data[1] < 4) ? Data[1] : MDF_FREQUENCY;     
     gEeprom.CROSS_BAND_RX_TX      = (Data[2] < 3) ? Data[2] : CROSS_BAND_OFF;
-    gEeprom.BATTERY_SAVE          = (Data[3] < 6) ? Data[3] : 4;
+    gEeprom.BATTERY_SAVE          = (Data[3] < BATTERY_SAVE_LEN) ? Data[3] : 4;
     gEeprom.DUAL_WATCH            = (Data[4] < 3) ? Data[4] : DUAL_WATCH_CHAN_A;
     gEeprom.BACKLIGHT_TIME        = (Data[5] < 62) ? Data[5] : 12;
     #ifdef ENABLE_FEAT_F4HWN_NARROWER
@@ -72,7 +74,10 @@ void SETTINGS_InitEEPROM(void)
         gEeprom.VFO_OPEN              = (Data[7] < 2) ? Data[7] : true;
     #endif
 
-    PY25Q16_ReadBuffer(0x005000, Data, 8);
+    // the 8-byte records are read at the size they are saved with, so their
+    // stamps let an unchanged save skip the flash write
+    Data = Buf;
+    PY25Q16_ReadRecord(0x005000, Buf, 8);
     gEeprom.ScreenChannel[0]   = IS_VALID_CHANNEL(Data[0]) ? Data[0] : (FREQ_CHANNEL_FIRST + BAND6_400MHz);
     gEeprom.ScreenChannel[1]   = IS_VALID_CHANNEL(Data[3]) ? Data[3] : (FREQ_CHANNEL_FIRST + BAND6_400MHz);
     gEeprom.MrChannel[0]       = IS_MR_CHANNEL(Data[1])    ? Data[1] : MR_CHANNEL_FIRST;
@@ -110,7 +115,7 @@ void SETTINGS_InitEEPROM(void)
     FM_ConfigureChannelState();
 #endif
 
-    PY25Q16_ReadBuffer(0x007000, Data, 8);
+    PY25Q16_ReadRecord(0x007000, Buf, 0x50);
     gEeprom.BEEP_CONTROL                 = Data[0] & 1;
     gEeprom.KEY_M_LONG_PRESS_ACTION      = ((Data[0] >> 1) < ACTION_OPT_LEN) ? (Data[0] >> 1) : ACTION_OPT_NONE;
     gEeprom.KEY_1_SHORT_PRESS_ACTION     = (Data[1] < ACTION_OPT_LEN) ? Data[1] : ACTION_OPT_MONITOR;
@@ -126,11 +131,11 @@ void SETTINGS_InitEEPROM(void)
 #endif
 
     #ifdef ENABLE_PWRON_PASSWORD
-        PY25Q16_ReadBuffer(0x007000 + 0x8, Data, 8);
+        Data = Buf + 0x8;
         memcpy(&gEeprom.POWER_ON_PASSWORD, Data, 4);
     #endif
 
-    PY25Q16_ReadBuffer(0x007000 + 0x10, Data, 8);
+    Data = Buf + 0x10;
     #ifdef ENABLE_VOICE
     gEeprom.VOICE_PROMPT = (Data[0] < 3) ? Data[0] : VOICE_PROMPT_ENGLISH;
     #endif
@@ -145,7 +150,7 @@ void SETTINGS_InitEEPROM(void)
         }
     #endif
 
-    PY25Q16_ReadBuffer(0x007000 + 0x18, Data, 8);
+    Data = Buf + 0x18;
     #ifdef ENABLE_ALARM
         gEeprom.ALARM_MODE                 = (Data[0] <  2) ? Data[0] : true;
     #endif
@@ -154,7 +159,7 @@ void SETTINGS_InitEEPROM(void)
     gEeprom.TX_VFO                         = (Data[3] <  2) ? Data[3] : 0;
     gEeprom.BATTERY_TYPE                   = (Data[4] < BATTERY_TYPE_UNKNOWN) ? Data[4] : BATTERY_TYPE_1600_MAH;
 
-    PY25Q16_ReadBuffer(0x007000 + 0x40, Data, 8);
+    Data = Buf + 0x40;
     gEeprom.DTMF_SIDE_TONE               = (Data[0] <   2) ? Data[0] : true;
 
 #ifdef ENABLE_DTMF_CALLING
@@ -167,27 +172,31 @@ void SETTINGS_InitEEPROM(void)
     gEeprom.DTMF_FIRST_CODE_PERSIST_TIME = (Data[6] < 101) ? Data[6] * 10 : 100;
     gEeprom.DTMF_HASH_CODE_PERSIST_TIME  = (Data[7] < 101) ? Data[7] * 10 : 100;
 
-    PY25Q16_ReadBuffer(0x007000 + 0x48, Data, 8);
+    Data = Buf + 0x48;
     gEeprom.DTMF_CODE_PERSIST_TIME  = (Data[0] < 101) ? Data[0] * 10 : 100;
     gEeprom.DTMF_CODE_INTERVAL_TIME = (Data[1] < 101) ? Data[1] * 10 : 100;
 #ifdef ENABLE_DTMF_CALLING
     gEeprom.PERMIT_REMOTE_KILL      = (Data[2] <   2) ? Data[2] : true;
+#endif
 
-    PY25Q16_ReadBuffer(0x008000, Data, sizeof(gEeprom.ANI_DTMF_ID));
+    PY25Q16_ReadBuffer(0x008000, Buf, 0x28 + sizeof(gEeprom.DTMF_DOWN_CODE));
+
+#ifdef ENABLE_DTMF_CALLING
+    Data = Buf;
     if (DTMF_ValidateCodes((char *)Data, sizeof(gEeprom.ANI_DTMF_ID))) {
         memcpy(gEeprom.ANI_DTMF_ID, Data, sizeof(gEeprom.ANI_DTMF_ID));
     } else {
         strcpy(gEeprom.ANI_DTMF_ID, "123");
     }
 
-    PY25Q16_ReadBuffer(0x008000 + 0x8, Data, sizeof(gEeprom.KILL_CODE));
+    Data = Buf + 0x8;
     if (DTMF_ValidateCodes((char *)Data, sizeof(gEeprom.KILL_CODE))) {
         memcpy(gEeprom.KILL_CODE, Data, sizeof(gEeprom.KILL_CODE));
     } else {
         strcpy(gEeprom.KILL_CODE, "ABCD9");
     }
 
-    PY25Q16_ReadBuffer(0x008000 + 0x10, Data, sizeof(gEeprom.REVIVE_CODE));
+    Data = Buf + 0x10;
     if (DTMF_ValidateCodes((char *)Data, sizeof(gEeprom.REVIVE_CODE))) {
         memcpy(gEeprom.REVIVE_CODE, Data, sizeof(gEeprom.REVIVE_CODE));
     } else {
@@ -195,21 +204,22 @@ void SETTINGS_InitEEPROM(void)
     }
 #endif
 
-    PY25Q16_ReadBuffer(0x008000 + 0x18, Data, sizeof(gEeprom.DTMF_UP_CODE));
+    Data = Buf + 0x18;
     if (DTMF_ValidateCodes((char *)Data, sizeof(gEeprom.DTMF_UP_CODE))) {
         memcpy(gEeprom.DTMF_UP_CODE, Data, sizeof(gEeprom.DTMF_UP_CODE));
     } else {
         strcpy(gEeprom.DTMF_UP_CODE, "12345");
     }
 
-    PY25Q16_ReadBuffer(0x008000 + 0x28, Data, sizeof(gEeprom.DTMF_DOWN_CODE));
+    Data = Buf + 0x28;
     if (DTMF_ValidateCodes((char *)Data, sizeof(gEeprom.DTMF_DOWN_CODE))) {
         memcpy(gEeprom.DTMF_DOWN_CODE, Data, sizeof(gEeprom.DTMF_DOWN_CODE));
     } else {
         strcpy(gEeprom.DTMF_DOWN_CODE, "54321");
     }
 
-    PY25Q16_ReadBuffer(0x009000, Data, 8);
+    Data = Buf;
+    PY25Q16_ReadRecord(0x009000, Buf, 8);
     gEeprom.SCAN_LIST_DEFAULT = (Data[0] < 6) ? Data[0] : 0;   
 
     for (unsigned int i = 0; i < 3; i++)
@@ -224,7 +234,7 @@ void SETTINGS_InitEEPROM(void)
         gEeprom.SCANLIST_PRIORITY_CH2[i] =  Data[j + 2];
     }
 
-    PY25Q16_ReadBuffer(0x00b000, Data, 8);
+    PY25Q16_ReadRecord(0x00b000, Buf, 8);
     gSetting_F_LOCK            = (Data[0] < F_LOCK_LEN) ? Data[0] : F_LOCK_DEF;
 #ifndef ENABLE_FEAT_F4HWN
     gSetting_350TX             = (Data[1] < 2) ? Data[1] : false;   
@@ -244,7 +254,11 @@ void SETTINGS_InitEEPROM(void)
 #endif
 
     gSetting_live_DTMF_decoder = !!(Data[7] & (1u << 1));
+#ifdef ENABLE_BATTERY_ESTIMATOR
+    gSetting_battery_text      = (Data[7] >> 2) & 3;
+#else
     gSetting_battery_text      = (((Data[7] >> 2) & 3u) <= 2) ? (Data[7] >> 2) & 3 : 2;
+#endif
     #ifdef ENABLE_AUDIO_BAR
         gSetting_mic_bar       = !!(Data[7] & (1u << 4));
     #endif
@@ -257,15 +271,8 @@ void SETTINGS_InitEEPROM(void)
         gEeprom.ScreenChannel[1] = gEeprom.MrChannel[1];
     }
 
-    PY25Q16_ReadBuffer(0x002000, gMR_ChannelAttributes, sizeof(gMR_ChannelAttributes));
-    for(uint16_t i = 0; i < sizeof(gMR_ChannelAttributes); i++) {
-        ChannelAttributes_t *att = &gMR_ChannelAttributes[i];
-        if(att->__val == 0xff){
-            att->__val = 0;
-            att->band = 0x7;
-        }
-        gMR_ChannelExclude[i] = false;
-    }
+    SETTINGS_LoadChannelAttributes();
+    memset(gMR_ChannelExclude, 0, sizeof(gMR_ChannelExclude));
 
         PY25Q16_ReadBuffer(0x00a000, gCustomAesKey, sizeof(gCustomAesKey));
         bHasCustomAesKey = false;
@@ -282,7 +289,7 @@ void SETTINGS_InitEEPROM(void)
 
     #ifdef ENABLE_FEAT_F4HWN
 
-        PY25Q16_ReadBuffer(0x00c000, Data, 8);
+        PY25Q16_ReadRecord(0x00c000, Buf, 8);
         gSetting_set_pwr = (((Data[7] & 0xF0) >> 4) < 7) ? ((Data[7] & 0xF0) >> 4) : 0;
         gSetting_set_ptt = (((Data[7] & 0x0F)) < 2) ? ((Data[7] & 0x0F)) : 0;
 
@@ -317,19 +324,35 @@ void SETTINGS_InitEEPROM(void)
     #endif
 }
 
+void SETTINGS_LoadChannelAttributes(void)
+{
+    PY25Q16_ReadBuffer(0x002000, gMR_ChannelAttributes, sizeof(gMR_ChannelAttributes));
+    for(uint16_t i = 0; i < ARRAY_SIZE(gMR_ChannelAttributes); i++) {
+        ChannelAttributes_t *att = &gMR_ChannelAttributes[i];
+        if(att->__val == 0xff){
+            att->__val = 0;
+            att->band = 0x7;
+        }
+    }
+}
+
 void SETTINGS_LoadCalibration(void)
 {
+    // 0x0c0..0x18f of the calibration sector in one read
+    uint8_t Cal[0x190 - 0xc0];
 
-    PY25Q16_ReadBuffer(0x010000 + 0xc0, gEEPROM_RSSI_CALIB[3], 8);
+    PY25Q16_ReadBuffer(0x010000 + 0xc0, Cal, sizeof(Cal));
+
+    memcpy(gEEPROM_RSSI_CALIB[3], Cal + 0x00, 8);
     memcpy(gEEPROM_RSSI_CALIB[4], gEEPROM_RSSI_CALIB[3], 8);
     memcpy(gEEPROM_RSSI_CALIB[5], gEEPROM_RSSI_CALIB[3], 8);
     memcpy(gEEPROM_RSSI_CALIB[6], gEEPROM_RSSI_CALIB[3], 8);
 
-    PY25Q16_ReadBuffer(0x010000 + 0xc8, gEEPROM_RSSI_CALIB[0], 8);
+    memcpy(gEEPROM_RSSI_CALIB[0], Cal + 0x08, 8);
     memcpy(gEEPROM_RSSI_CALIB[1], gEEPROM_RSSI_CALIB[0], 8);
     memcpy(gEEPROM_RSSI_CALIB[2], gEEPROM_RSSI_CALIB[0], 8);
 
-    PY25Q16_ReadBuffer(0x010000 + 0x140, gBatteryCalibration, 12);
+    memcpy(gBatteryCalibration, Cal + 0x80, 12);
     if (gBatteryCalibration[0] >= 5000)
     {
         gBatteryCalibration[0] = 1900;
@@ -339,9 +362,9 @@ void SETTINGS_LoadCalibration(void)
 
     #ifdef ENABLE_VOX
          
-        PY25Q16_ReadBuffer(0x010000 + 0x150 + (gEeprom.VOX_LEVEL * 2), &gEeprom.VOX1_THRESHOLD, 2);
+        memcpy(&gEeprom.VOX1_THRESHOLD, Cal + 0x90 + (gEeprom.VOX_LEVEL * 2), 2);
          
-        PY25Q16_ReadBuffer(0x010000 + 0x168 + (gEeprom.VOX_LEVEL * 2), &gEeprom.VOX0_THRESHOLD, 2);
+        memcpy(&gEeprom.VOX0_THRESHOLD, Cal + 0xa8 + (gEeprom.VOX_LEVEL * 2), 2);
     #endif
 
     gEeprom.MIC_SENSITIVITY_TUNING = gMicGain_dB2[gEeprom.MIC_SENSITIVITY];
@@ -356,7 +379,7 @@ void SETTINGS_LoadCalibration(void)
             uint8_t  DAC_GAIN;
         } __attribute__((packed)) Misc;
 
-        PY25Q16_ReadBuffer(0x010000 + 0x188, &Misc, 8);
+        memcpy(&Misc, Cal + 0xc8, 8);
 
         gEeprom.BK4819_XTAL_FREQ_LOW = (Misc.BK4819_XtalFreqLow >= -1000 && Misc.BK4819_XtalFreqLow <= 1000) ? Misc.BK4819_XtalFreqLow : 0;
         gEEPROM_1F8A                 = Misc.EEPROM_1F8A & 0x01FF;
@@ -386,6 +409,19 @@ uint32_t SETTINGS_FetchChannelFrequency(const int channel)
     return info.frequency;
 }
 
+static void TrimChannelName(char *s)
+{
+    int i;
+    for (i = 0; i < 10; i++)
+        if (s[i] < 32 || s[i] > 127)
+            break;                 
+
+    s[i--] = 0;                    
+
+    while (i >= 0 && s[i] == 32)   
+        s[i--] = 0;                
+}
+
 void SETTINGS_FetchChannelName(char *s, const int channel)
 {
     if (s == NULL)
@@ -400,18 +436,148 @@ void SETTINGS_FetchChannelName(char *s, const int channel)
         return;
 
     PY25Q16_ReadBuffer(0x00e000 + (channel * 16), s, 10);
+    TrimChannelName(s);
+}
 
-    int i;
-    for (i = 0; i < 10; i++)
-        if (s[i] < 32 || s[i] > 127)
-            break;                 
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+ChannelNameIndex_t gChannelNameIndex;
 
-    s[i--] = 0;                    
+static char NameFold(char c)
+{
+    return (c >= 'a' && c <= 'z') ? c - 'a' + 'A' : c;
+}
 
-    while (i >= 0 && s[i] == 32)   
-        s[i--] = 0;                
+// 0: below 'A', 1..26: letters, 27: above 'Z'
+static uint8_t NameClass(char c)
+{
+    c = NameFold(c);
+    return (c < 'A') ? 0 : (c <= 'Z') ? c - 'A' + 1 : NAME_INDEX_CLASSES - 1;
+}
+
+static int NameCompare(const char *a, const char *b, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; i++) {
+        const char x = NameFold(a[i]);
+        const char y = NameFold(b[i]);
+        if (x != y)
+            return x - y;
+        if (x == 0)
+            break;
+    }
+    return 0;
+}
+
+// from the cached name area when pNames is set, else straight from flash
+static void NameIndexRead(char *s, const char *pNames, uint8_t channel)
+{
+    if (pNames == NULL) {
+        SETTINGS_FetchChannelName(s, channel);
+        return;
+    }
+
+    s[0] = 0;
+    if (!RADIO_CheckValidChannel(channel, false, 0))
+        return;
+
+    memcpy(s, pNames + channel * 16, 10);
+    TrimChannelName(s);
+}
+
+static void NameIndexInsert(uint8_t channel, const char *pNames)
+{
+    ChannelNameIndex_t *pIndex = &gChannelNameIndex;
+    char Name[11];
+    char Other[11];
+
+    NameIndexRead(Name, pNames, channel);
+    if (Name[0] == 0)
+        return;
+
+    // only the names of the same class are compared
+    const uint8_t Class = NameClass(Name[0]);
+    unsigned int  lo    = pIndex->Bucket[Class];
+    unsigned int  hi    = pIndex->Bucket[Class + 1];
+
+    while (lo < hi) {
+        const unsigned int mid = (lo + hi) / 2;
+        NameIndexRead(Other, pNames, pIndex->Channel[mid]);
+        const int r = NameCompare(Other, Name, sizeof(Name));
+        if (r < 0 || (r == 0 && pIndex->Channel[mid] < channel))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    memmove(&pIndex->Channel[lo + 1], &pIndex->Channel[lo], pIndex->Count - lo);
+    pIndex->Channel[lo] = channel;
+    pIndex->Count++;
+
+    for (unsigned int c = Class + 1; c <= NAME_INDEX_CLASSES; c++)
+        pIndex->Bucket[c]++;
+}
+
+void SETTINGS_BuildChannelNameIndex(void)
+{
+    // all names sit in one flash sector: read it once and sort from RAM
+    const char *pNames = (const char *)PY25Q16_CacheSector(0x00e000);
+
+    memset(&gChannelNameIndex, 0, sizeof(gChannelNameIndex));
+
+    for (unsigned int channel = 0; channel <= MR_CHANNEL_LAST; channel++)
+        NameIndexInsert(channel, pNames);
+}
+
+void SETTINGS_UpdateChannelNameIndex(uint8_t channel)
+{
+    ChannelNameIndex_t *pIndex = &gChannelNameIndex;
+
+    for (unsigned int pos = 0; pos < pIndex->Count; pos++) {
+        if (pIndex->Channel[pos] != channel)
+            continue;
+
+        pIndex->Count--;
+        memmove(&pIndex->Channel[pos], &pIndex->Channel[pos + 1], pIndex->Count - pos);
+
+        for (unsigned int c = 1; c <= NAME_INDEX_CLASSES; c++)
+            if (pIndex->Bucket[c] > pos)
+                pIndex->Bucket[c]--;
+        break;
+    }
+
+    NameIndexInsert(channel, NULL);
 }
 
+// position of the first name starting with pPrefix, -1 if there is none
+int SETTINGS_FindChannelName(const char *pPrefix)
+{
+    const ChannelNameIndex_t *pIndex = &gChannelNameIndex;
+    const unsigned int        Len    = strlen(pPrefix);
+    char                      Name[11];
+
+    if (Len == 0)
+        return pIndex->Count ? 0 : -1;
+
+    const uint8_t Class = NameClass(pPrefix[0]);
+    unsigned int  lo    = pIndex->Bucket[Class];
+    unsigned int  hi    = pIndex->Bucket[Class + 1];
+
+    while (lo < hi) {
+        const unsigned int mid = (lo + hi) / 2;
+        SETTINGS_FetchChannelName(Name, pIndex->Channel[mid]);
+        if (NameCompare(Name, pPrefix, Len) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo == pIndex->Bucket[Class + 1])
+        return -1;
+
+    SETTINGS_FetchChannelName(Name, pIndex->Channel[lo]);
+    return NameCompare(Name, pPrefix, Len) == 0 ? (int)lo : -1;
+}
+#endif
+
 void SETTINGS_FactoryReset(bool bIsAll)
 {
      
@@ -514,7 +680,7 @@ void SETTINGS_SaveVfoIndices(void)
 
     #ifndef ENABLE_NOAA
          
-        PY25Q16_ReadBuffer(0x005000, State, sizeof(State));
+        PY25Q16_ReadRecord(0x005000, State, sizeof(State));
     #endif
 
     State[0] = gEeprom.ScreenChannel[0];
@@ -532,215 +698,229 @@ void SETTINGS_SaveVfoIndices(void)
 }
 
 void SETTINGS_SaveSettings(void)
+{
+    SETTINGS_SaveSettingsRecords(SETTINGS_RECORD_ALL);
+}
+
+void SETTINGS_SaveSettingsRecords(uint8_t Records)
 {
     uint8_t *State;
     uint8_t tmp = 0;
     uint8_t SecBuf[0x50];
 
-    memset(SecBuf, 0xff, 0x10);
-
-    State = SecBuf;
-    State[0] = gEeprom.CHAN_1_CALL;
-    State[1] = gEeprom.SQUELCH_LEVEL;
-    State[2] = gEeprom.TX_TIMEOUT_TIMER;
-    #ifdef ENABLE_NOAA
-        State[3] = gEeprom.NOAA_AUTO_SCAN;
-    #else
-        State[3] = false;
-    #endif
+    if (Records & SETTINGS_RECORD_MAIN) {
+        memset(SecBuf, 0xff, 0x10);
+
+        State = SecBuf;
+        State[0] = gEeprom.CHAN_1_CALL;
+        State[1] = gEeprom.SQUELCH_LEVEL;
+        State[2] = gEeprom.TX_TIMEOUT_TIMER;
+        #ifdef ENABLE_NOAA
+            State[3] = gEeprom.NOAA_AUTO_SCAN;
+        #else
+            State[3] = false;
+        #endif
 
-        State[4] = gEeprom.KEY_LOCK;
+            State[4] = gEeprom.KEY_LOCK;
 
-    #ifdef ENABLE_VOX
-        State[5] = gEeprom.VOX_SWITCH;
-        State[6] = gEeprom.VOX_LEVEL;
-    #else
-        State[5] = false;
-        State[6] = 0;
-    #endif
-    State[7] = gEeprom.MIC_SENSITIVITY;
+        #ifdef ENABLE_VOX
+            State[5] = gEeprom.VOX_SWITCH;
+            State[6] = gEeprom.VOX_LEVEL;
+        #else
+            State[5] = false;
+            State[6] = 0;
+        #endif
+        State[7] = gEeprom.MIC_SENSITIVITY;
 
-    State = SecBuf + 0x8;
-    State[0] = (gEeprom.BACKLIGHT_MIN << 4) + gEeprom.BACKLIGHT_MAX;
-    State[1] = gEeprom.CHANNEL_DISPLAY_MODE;
-    State[2] = gEeprom.CROSS_BAND_RX_TX;
-    State[3] = gEeprom.BATTERY_SAVE;
-    State[4] = gEeprom.DUAL_WATCH;
+        State = SecBuf + 0x8;
+        State[0] = (gEeprom.BACKLIGHT_MIN << 4) + gEeprom.BACKLIGHT_MAX;
+        State[1] = gEeprom.CHANNEL_DISPLAY_MODE;
+        State[2] = gEeprom.CROSS_BAND_RX_TX;
+        State[3] = gEeprom.BATTERY_SAVE;
+        State[4] = gEeprom.DUAL_WATCH;
 
-    #ifdef ENABLE_FEAT_F4HWN
-        if(!gSaveRxMode)
-        {
-            State[2] = gCB;
-            State[4] = gDW;
-        }
-        if(gBackLight)
-        {
-            State[5] = gBacklightTimeOriginal;
-        }
-        else
-        {
+        #ifdef ENABLE_FEAT_F4HWN
+            if(!gSaveRxMode)
+            {
+                State[2] = gCB;
+                State[4] = gDW;
+            }
+            if(gBackLight)
+            {
+                State[5] = gBacklightTimeOriginal;
+            }
+            else
+            {
+                State[5] = gEeprom.BACKLIGHT_TIME;
+            }
+        #else
             State[5] = gEeprom.BACKLIGHT_TIME;
-        }
-    #else
-        State[5] = gEeprom.BACKLIGHT_TIME;
-    #endif
-
-    #ifdef ENABLE_FEAT_F4HWN_NARROWER
-        State[6] = (gEeprom.TAIL_TONE_ELIMINATION & 0x01) | ((gSetting_set_nfm & 0x03) << 1);
-    #else
-        State[6] = gEeprom.TAIL_TONE_ELIMINATION;
-    #endif
-
-    #ifdef ENABLE_FEAT_F4HWN_RESUME_STATE
-        State[7] = (gEeprom.VFO_OPEN & 0x01) | ((gEeprom.CURRENT_STATE & 0x07) << 1) | ((gEeprom.SCAN_LIST_DEFAULT & 0x07) << 4);
-    #else
-        State[7] = gEeprom.VFO_OPEN;
-    #endif
+        #endif
 
-    PY25Q16_WriteBuffer(0x004000, SecBuf, 0x10, true);
+        #ifdef ENABLE_FEAT_F4HWN_NARROWER
+            State[6] = (gEeprom.TAIL_TONE_ELIMINATION & 0x01) | ((gSetting_set_nfm & 0x03) << 1);
+        #else
+            State[6] = gEeprom.TAIL_TONE_ELIMINATION;
+        #endif
 
-    PY25Q16_ReadBuffer(0x007000, SecBuf, 0x50);
+        #ifdef ENABLE_FEAT_F4HWN_RESUME_STATE
+            State[7] = (gEeprom.VFO_OPEN & 0x01) | ((gEeprom.CURRENT_STATE & 0x07) << 1) | ((gEeprom.SCAN_LIST_DEFAULT & 0x07) << 4);
+        #else
+            State[7] = gEeprom.VFO_OPEN;
+        #endif
 
-    State = SecBuf;
-    State[0] = gEeprom.BEEP_CONTROL;
-    State[0] |= gEeprom.KEY_M_LONG_PRESS_ACTION << 1;
-    State[1] = gEeprom.KEY_1_SHORT_PRESS_ACTION;
-    State[2] = gEeprom.KEY_1_LONG_PRESS_ACTION;
-    State[3] = gEeprom.KEY_2_SHORT_PRESS_ACTION;
-    State[4] = gEeprom.KEY_2_LONG_PRESS_ACTION;
-    State[5] = gEeprom.SCAN_RESUME_MODE;
-    State[6] = gEeprom.AUTO_KEYPAD_LOCK;
-    State[7] = gEeprom.POWER_ON_DISPLAY_MODE;
+        PY25Q16_WriteBuffer(0x004000, SecBuf, 0x10, true);
+    }
 
-    #ifdef ENABLE_PWRON_PASSWORD
-        State = SecBuf + 0x8;
-        State[0] = gEeprom.POWER_ON_PASSWORD;
-    #endif
+    if (Records & SETTINGS_RECORD_KEYS) {
+        PY25Q16_ReadRecord(0x007000, SecBuf, 0x50);
+
+        State = SecBuf;
+        State[0] = gEeprom.BEEP_CONTROL;
+        State[0] |= gEeprom.KEY_M_LONG_PRESS_ACTION << 1;
+        State[1] = gEeprom.KEY_1_SHORT_PRESS_ACTION;
+        State[2] = gEeprom.KEY_1_LONG_PRESS_ACTION;
+        State[3] = gEeprom.KEY_2_SHORT_PRESS_ACTION;
+        State[4] = gEeprom.KEY_2_LONG_PRESS_ACTION;
+        State[5] = gEeprom.SCAN_RESUME_MODE;
+        State[6] = gEeprom.AUTO_KEYPAD_LOCK;
+        State[7] = gEeprom.POWER_ON_DISPLAY_MODE;
+
+        #ifdef ENABLE_PWRON_PASSWORD
+            State = SecBuf + 0x8;
+            State[0] = gEeprom.POWER_ON_PASSWORD;
+        #endif
 
-    State = SecBuf + 0x10;
+        State = SecBuf + 0x10;
 #ifdef ENABLE_VOICE
-    State[0] = gEeprom.VOICE_PROMPT;
+        State[0] = gEeprom.VOICE_PROMPT;
 #endif
 #ifdef ENABLE_RSSI_BAR
-    State[1] = gEeprom.S0_LEVEL;
-    State[2] = gEeprom.S9_LEVEL;
+        State[1] = gEeprom.S0_LEVEL;
+        State[2] = gEeprom.S9_LEVEL;
 #endif
 
-    State = SecBuf + 0x18;
-    #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
-        State[0] = gEeprom.ALARM_MODE;
-    #else
-        State[0] = false;
-    #endif
-    State[1] = gEeprom.ROGER;
-    State[2] = gEeprom.REPEATER_TAIL_TONE_ELIMINATION;
-    State[3] = gEeprom.TX_VFO;
-    State[4] = gEeprom.BATTERY_TYPE;
+        State = SecBuf + 0x18;
+        #if defined(ENABLE_ALARM) || defined(ENABLE_TX1750)
+            State[0] = gEeprom.ALARM_MODE;
+        #else
+            State[0] = false;
+        #endif
+        State[1] = gEeprom.ROGER;
+        State[2] = gEeprom.REPEATER_TAIL_TONE_ELIMINATION;
+        State[3] = gEeprom.TX_VFO;
+        State[4] = gEeprom.BATTERY_TYPE;
 
-    State = SecBuf + 0x40;
-    State[0] = gEeprom.DTMF_SIDE_TONE;
+        State = SecBuf + 0x40;
+        State[0] = gEeprom.DTMF_SIDE_TONE;
 #ifdef ENABLE_DTMF_CALLING
-    State[1] = gEeprom.DTMF_SEPARATE_CODE;
-    State[2] = gEeprom.DTMF_GROUP_CALL_CODE;
-    State[3] = gEeprom.DTMF_DECODE_RESPONSE;
-    State[4] = gEeprom.DTMF_auto_reset_time;
-#endif
-    State[5] = gEeprom.DTMF_PRELOAD_TIME / 10U;
-    State[6] = gEeprom.DTMF_FIRST_CODE_PERSIST_TIME / 10U;
-    State[7] = gEeprom.DTMF_HASH_CODE_PERSIST_TIME / 10U;
-
-    State = SecBuf + 0x48;
-    State[0] = gEeprom.DTMF_CODE_PERSIST_TIME / 10U;
-    State[1] = gEeprom.DTMF_CODE_INTERVAL_TIME / 10U;
+        State[1] = gEeprom.DTMF_SEPARATE_CODE;
+        State[2] = gEeprom.DTMF_GROUP_CALL_CODE;
+        State[3] = gEeprom.DTMF_DECODE_RESPONSE;
+        State[4] = gEeprom.DTMF_auto_reset_time;
+#endif
+        State[5] = gEeprom.DTMF_PRELOAD_TIME / 10U;
+        State[6] = gEeprom.DTMF_FIRST_CODE_PERSIST_TIME / 10U;
+        State[7] = gEeprom.DTMF_HASH_CODE_PERSIST_TIME / 10U;
+
+        State = SecBuf + 0x48;
+        State[0] = gEeprom.DTMF_CODE_PERSIST_TIME / 10U;
+        State[1] = gEeprom.DTMF_CODE_INTERVAL_TIME / 10U;
 #ifdef ENABLE_DTMF_CALLING
-    State[2] = gEeprom.PERMIT_REMOTE_KILL;
+        State[2] = gEeprom.PERMIT_REMOTE_KILL;
 #endif
 
-    PY25Q16_WriteBuffer(0x007000, SecBuf, 0x50, true);
+        PY25Q16_WriteBuffer(0x007000, SecBuf, 0x50, true);
+    }
 
-    memset(SecBuf, 0xff, 0x8);
+    if (Records & SETTINGS_RECORD_SCAN) {
+        memset(SecBuf, 0xff, 0x8);
 
-    State = SecBuf;
-    State[0] = gEeprom.SCAN_LIST_DEFAULT;
+        State = SecBuf;
+        State[0] = gEeprom.SCAN_LIST_DEFAULT;
 
-    tmp = 0;
+        tmp = 0;
 
-    if (gEeprom.SCAN_LIST_ENABLED[0] == 1)
-        tmp = tmp | (1 << 0);
-    if (gEeprom.SCAN_LIST_ENABLED[1] == 1)
-        tmp = tmp | (1 << 1);
-    if (gEeprom.SCAN_LIST_ENABLED[2] == 1)
-        tmp = tmp | (1 << 2);
+        if (gEeprom.SCAN_LIST_ENABLED[0] == 1)
+            tmp = tmp | (1 << 0);
+        if (gEeprom.SCAN_LIST_ENABLED[1] == 1)
+            tmp = tmp | (1 << 1);
+        if (gEeprom.SCAN_LIST_ENABLED[2] == 1)
+            tmp = tmp | (1 << 2);
 
-    State[1] = tmp;
-    State[2] = gEeprom.SCANLIST_PRIORITY_CH1[0];
-    State[3] = gEeprom.SCANLIST_PRIORITY_CH2[0];
-    State[4] = gEeprom.SCANLIST_PRIORITY_CH1[1];
-    State[5] = gEeprom.SCANLIST_PRIORITY_CH2[1];
-    State[6] = gEeprom.SCANLIST_PRIORITY_CH1[2];
-    State[7] = gEeprom.SCANLIST_PRIORITY_CH2[2];
+        State[1] = tmp;
+        State[2] = gEeprom.SCANLIST_PRIORITY_CH1[0];
+        State[3] = gEeprom.SCANLIST_PRIORITY_CH2[0];
+        State[4] = gEeprom.SCANLIST_PRIORITY_CH1[1];
+        State[5] = gEeprom.SCANLIST_PRIORITY_CH2[1];
+        State[6] = gEeprom.SCANLIST_PRIORITY_CH1[2];
+        State[7] = gEeprom.SCANLIST_PRIORITY_CH2[2];
 
-    PY25Q16_WriteBuffer(0x009000, SecBuf, 8, true);
+        PY25Q16_WriteBuffer(0x009000, SecBuf, 8, true);
+    }
 
-    memset(SecBuf, 0xff, 8);
+    if (Records & SETTINGS_RECORD_FLAGS) {
+        memset(SecBuf, 0xff, 8);
 
-    State = SecBuf;
-    State[0]  = gSetting_F_LOCK;
+        State = SecBuf;
+        State[0]  = gSetting_F_LOCK;
 #ifndef ENABLE_FEAT_F4HWN
-    State[1]  = gSetting_350TX;
+        State[1]  = gSetting_350TX;
 #endif
 #ifdef ENABLE_DTMF_CALLING
-    State[2]  = gSetting_KILLED;
+        State[2]  = gSetting_KILLED;
 #endif
 #ifndef ENABLE_FEAT_F4HWN
-    State[3]  = gSetting_200TX;
-    State[4]  = gSetting_500TX;
+        State[3]  = gSetting_200TX;
+        State[4]  = gSetting_500TX;
 #endif
-    State[5]  = gSetting_350EN;
+        State[5]  = gSetting_350EN;
 #ifdef ENABLE_FEAT_F4HWN__  
-    State[6]  = false;
+        State[6]  = false;
 #else
-    State[6]  = gSetting_ScrambleEnable;
+        State[6]  = gSetting_ScrambleEnable;
 #endif
 
-    if (!gSetting_live_DTMF_decoder) State[7] &= ~(1u << 1);
-    State[7] = (State[7] & ~(3u << 2)) | ((gSetting_battery_text & 3u) << 2);
-    #ifdef ENABLE_AUDIO_BAR
-        if (!gSetting_mic_bar)           State[7] &= ~(1u << 4);
-    #endif
+        if (!gSetting_live_DTMF_decoder) State[7] &= ~(1u << 1);
+        State[7] = (State[7] & ~(3u << 2)) | ((gSetting_battery_text & 3u) << 2);
+        #ifdef ENABLE_AUDIO_BAR
+            if (!gSetting_mic_bar)           State[7] &= ~(1u << 4);
+        #endif
 
-    State[7] = (State[7] & ~(3u << 6)) | ((gSetting_backlight_on_tx_rx & 3u) << 6);
+        State[7] = (State[7] & ~(3u << 6)) | ((gSetting_backlight_on_tx_rx & 3u) << 6);
 
-    PY25Q16_WriteBuffer(0x00b000, SecBuf, 8, true);
+        PY25Q16_WriteBuffer(0x00b000, SecBuf, 8, true);
+    }
 
 #ifdef ENABLE_FEAT_F4HWN
-     
-    State = SecBuf;
-     
-    PY25Q16_ReadBuffer(0x00c000, State, 8);
+    if (Records & SETTINGS_RECORD_F4HWN) {
+        State = SecBuf;
+        PY25Q16_ReadRecord(0x00c000, State, 8);
 
 #ifdef ENABLE_FEAT_F4HWN_SLEEP 
-    State[4] = (gSetting_set_off << 1) | (gSetting_set_tmr & 0x01);
+        State[4] = (gSetting_set_off << 1) | (gSetting_set_tmr & 0x01);
 #else
-    State[4] = gSetting_set_tmr ? (1 << 0) : 0;
+        State[4] = gSetting_set_tmr ? (1 << 0) : 0;
 #endif
 
-    tmp =   (gSetting_set_inv << 0) |
-            (gSetting_set_lck << 1) |
-            (gSetting_set_met << 2) |
-            (gSetting_set_gui << 3);
+        tmp =   (gSetting_set_inv << 0) |
+                (gSetting_set_lck << 1) |
+                (gSetting_set_met << 2) |
+                (gSetting_set_gui << 3);
 
-    State[5] = ((tmp << 4) | (gSetting_set_ctr & 0x0F));
-    State[6] = ((gSetting_set_tot << 4) | (gSetting_set_eot & 0x0F));
-    State[7] = ((gSetting_set_pwr << 4) | (gSetting_set_ptt & 0x0F));
+        State[5] = ((tmp << 4) | (gSetting_set_ctr & 0x0F));
+        State[6] = ((gSetting_set_tot << 4) | (gSetting_set_eot & 0x0F));
+        State[7] = ((gSetting_set_pwr << 4) | (gSetting_set_ptt & 0x0F));
 
-    gEeprom.KEY_LOCK_PTT = gSetting_set_lck;
+        gEeprom.KEY_LOCK_PTT = gSetting_set_lck;
 
-    PY25Q16_WriteBuffer(0x00c000, SecBuf, 8, true);
+        PY25Q16_WriteBuffer(0x00c000, SecBuf, 8, true);
+    }
 #endif
 
 #ifdef ENABLE_FEAT_F4HWN_VOL
-    SETTINGS_WriteCurrentVol();
+    if (Records & SETTINGS_RECORD_VOL)
+        SETTINGS_WriteCurrentVol();
 #endif
 }
 
@@ -827,6 +1007,10 @@ void SETTINGS_SaveChannelName(uint8_t channel, const char * name)
     memcpy(buf, name, MIN(strlen(name), 10u));
      
     PY25Q16_WriteBuffer(0x00e000 + offset, buf, 0x10, false);
+
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+    SETTINGS_UpdateChannelNameIndex(channel);
+#endif
 }
 
 void SETTINGS_UpdateChannel(uint8_t channel, const VFO_Info_t *pVFO, bool keep, bool check, bool save)
@@ -863,10 +1047,7 @@ void SETTINGS_UpdateChannel(uint8_t channel, const VFO_Info_t *pVFO, bool keep,
 #endif
         if(save)
         {
-            uint8_t buf[224];
-            PY25Q16_ReadBuffer(0x002000, buf, sizeof(buf));
-            buf[channel] = state.__val;
-            PY25Q16_WriteBuffer(0x002000, buf, sizeof(buf), true);
+            PY25Q16_WriteBuffer(0x002000 + channel, &state, 1, false);
         }
 
         gMR_ChannelAttributes[channel] = att;
@@ -876,6 +1057,11 @@ void SETTINGS_UpdateChannel(uint8_t channel, const VFO_Info_t *pVFO, bool keep,
                  
                 SETTINGS_SaveChannelName(channel, "");
             }
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+            else {
+                SETTINGS_UpdateChannelNameIndex(channel);
+            }
+#endif
         }
     }
 }
@@ -886,7 +1072,7 @@ void SETTINGS_WriteBuildOptions(void)
 
 #ifdef ENABLE_FEAT_F4HWN
      
-    PY25Q16_ReadBuffer(0x00c000, State, sizeof(State));
+    PY25Q16_ReadRecord(0x00c000, State, sizeof(State));
 #endif
     
 State[0] = 0
@@ -944,7 +1130,7 @@ State[1] = 0
     {
         uint8_t State[0x10];
          
-        PY25Q16_ReadBuffer(0x004000, State, sizeof(State));
+        PY25Q16_ReadRecord(0x004000, State, sizeof(State));
          
         State[15] = (gEeprom.VFO_OPEN & 0x01) | ((gEeprom.CURRENT_STATE & 0x07) << 1) | ((gEeprom.SCAN_LIST_DEFAULT & 0x07) << 4);
         PY25Q16_WriteBuffer(0x004000, State, sizeof(State), true);
@@ -957,7 +1143,7 @@ State[1] = 0
     {
         uint8_t State[8];
          
-        PY25Q16_ReadBuffer(0x010000 + 0x188, State, sizeof(State));
+        PY25Q16_ReadRecord(0x010000 + 0x188, State, sizeof(State));
         State[6] = gEeprom.VOLUME_GAIN;
         PY25Q16_WriteBuffer(0x010000 + 0x188, State, sizeof(State), false);
     }
@@ -967,29 +1153,15 @@ State[1] = 0
 
 void SETTINGS_ResetTxLock(void)
 {
-
-#define SETTINGS_ResetTxLock_BATCH 10
-
-    uint8_t Buf[0xc80 / SETTINGS_ResetTxLock_BATCH];
-    const uint32_t BatchSize = 0xc80 / SETTINGS_ResetTxLock_BATCH;
-    const uint32_t BatchChCnt = BatchSize / 0x10;
-
-    for (uint32_t i = 0; i < SETTINGS_ResetTxLock_BATCH; i++)
+    PY25Q16_BeginUpdate();
+    for (uint8_t channel = 0; channel < 0xc80 / 0x10; channel++)
     {
-        uint32_t Offset = i * BatchSize;
-        PY25Q16_ReadBuffer(0 + Offset, Buf, sizeof(Buf));
-
-        uint8_t *State;
-        for (uint8_t channel = 0; channel < BatchChCnt; channel++)
-        {
-            uint16_t OffsetVFO = channel * 16;
-            State = Buf + OffsetVFO;
-            State[4] |= (1 << 6);
-        }
-
-        PY25Q16_WriteBuffer(0 + Offset, Buf, sizeof(Buf), false);
+        const uint16_t OffsetVFO = channel * 16;
+        uint8_t State;
+        PY25Q16_ReadBuffer(0 + OffsetVFO + 4, &State, 1);
+        State |= (1 << 6);
+        PY25Q16_WriteBuffer(0 + OffsetVFO + 4, &State, 1, false);
     }
-
-#undef SETTINGS_ResetTxLock_BATCH
+    PY25Q16_CommitUpdate();
 }
 #endif
@@ -8,6 +8,7 @@
 
 #include "frequencies.h"
 #include <helper/battery.h>
+#include "misc.h"
 #include "radio.h"
 #include <driver/backlight.h>
 
@@ -57,6 +58,26 @@ enum {
     DUAL_WATCH_CHAN_B
 };
 
+enum {
+    BATTERY_SAVE_OFF = 0,
+    BATTERY_SAVE_MAX_RATIO = 5,
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+    BATTERY_SAVE_AUTO,
+#endif
+    BATTERY_SAVE_LEN
+};
+
+// flash records written by SETTINGS_SaveSettingsRecords()
+enum {
+    SETTINGS_RECORD_MAIN  = 1u << 0,    // 0x004000 squelch, VFO modes, backlight
+    SETTINGS_RECORD_KEYS  = 1u << 1,    // 0x007000 keys, beep, roger, DTMF
+    SETTINGS_RECORD_SCAN  = 1u << 2,    // 0x009000 scan lists
+    SETTINGS_RECORD_FLAGS = 1u << 3,    // 0x00B000 TX lock and option flags
+    SETTINGS_RECORD_F4HWN = 1u << 4,    // 0x00C000
+    SETTINGS_RECORD_VOL   = 1u << 5,    // 0x010188
+    SETTINGS_RECORD_ALL   = 0x3F
+};
+
 enum {
     TX_OFFSET_FREQUENCY_DIRECTION_OFF = 0,
     TX_OFFSET_FREQUENCY_DIRECTION_ADD,
@@ -269,15 +290,34 @@ typedef struct {
 extern EEPROM_Config_t gEeprom;
 
 void     SETTINGS_InitEEPROM(void);
+void     SETTINGS_LoadChannelAttributes(void);
 void     SETTINGS_LoadCalibration(void);
 uint32_t SETTINGS_FetchChannelFrequency(const int channel);
 void     SETTINGS_FetchChannelName(char *s, const int channel);
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+    // named MR channels sorted by name (case folded, then channel number),
+    // Bucket[c] is the first position whose name starts in character class c
+    #define NAME_INDEX_CLASSES 28
+
+    typedef struct {
+        uint8_t Channel[MR_CHANNEL_LAST + 1];
+        uint8_t Bucket[NAME_INDEX_CLASSES + 1];
+        uint8_t Count;
+    } ChannelNameIndex_t;
+
+    extern ChannelNameIndex_t gChannelNameIndex;
+
+    void SETTINGS_BuildChannelNameIndex(void);
+    void SETTINGS_UpdateChannelNameIndex(uint8_t channel);
+    int  SETTINGS_FindChannelName(const char *pPrefix);
+#endif
 void     SETTINGS_FactoryReset(bool bIsAll);
 #ifdef ENABLE_FMRADIO
     void SETTINGS_SaveFM(void);
 #endif
 void SETTINGS_SaveVfoIndices(void);
 void SETTINGS_SaveSettings(void);
+void SETTINGS_SaveSettingsRecords(uint8_t Records);
 void SETTINGS_SaveChannelName(uint8_t channel, const char * name);
 void SETTINGS_SaveChannel(uint8_t Channel, uint8_t VFO, const VFO_Info_t *pVFO, uint8_t Mode);
 void SETTINGS_SaveBatteryCalibration(const uint16_t * batteryCalibration);
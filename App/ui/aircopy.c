@@ -62,6 +62,8 @@ void UI_DisplayAircopy(void)
         sprintf(String, "RCV:%02u.%02u%% E:%d", percent / 100, percent % 100, gErrorsDuringAirCopy);
     } else if (gAirCopyIsSendMode == 1) {
         sprintf(String, "SND:%02u.%02u%%", percent / 100, percent % 100);
+    } else {
+        sprintf(String, "SN2:%02u.%02u%%", percent / 100, percent % 100);
     }
 
     
@@ -84,13 +86,16 @@ void UI_DisplayAircopy(void)
     if(gAirCopyBlockNumber + gErrorsDuringAirCopy != 0)
     {
         
+        const unsigned int marks = MIN(gAirCopyBlockNumber + gErrorsDuringAirCopy, sizeof(crc) * 8u);
+
         if(gErrorsDuringAirCopy != lErrorsDuringAirCopy)
         {
-            set_bit(crc, gAirCopyBlockNumber + gErrorsDuringAirCopy);
+            if (marks < sizeof(crc) * 8u)
+                set_bit(crc, marks);
             lErrorsDuringAirCopy = gErrorsDuringAirCopy;
         }
 
-        for(uint8_t i = 0; i < (gAirCopyBlockNumber + gErrorsDuringAirCopy); i++)
+        for(uint8_t i = 0; i < marks; i++)
         {
             if(get_bit(crc, i) == 0)
             {
@@ -258,5 +258,4 @@ void UI_DisplayPopup(const char *string)
 void UI_DisplayClear()
 {
     memset(gFrameBuffer, 0, sizeof(gFrameBuffer));
-    memset(gFrameBufferOld, 1, sizeof(gFrameBufferOld));
 }
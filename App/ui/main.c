@@ -3,8 +3,14 @@
 #include <string.h>
 #include <stdlib.h>    
 
+#ifdef ENABLE_AM_FIX__
+    #include "am_fix.h"
+#endif
 #include "app/chFrScanner.h"
 #include "app/dtmf.h"
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+    #include "app/main.h"
+#endif
 #include "bitmaps.h"
 #include "board.h"
 #include "driver/bk4819.h"
@@ -27,6 +33,10 @@
 
 center_line_t center_line = CENTER_LINE_NONE;
 
+uint8_t gMainWidgetsDirty;
+
+static uint8_t dtmfLiveLength;
+
 #ifdef ENABLE_FEAT_F4HWN
     static int8_t RxBlink;
     static int8_t RxBlinkLed = 0;
@@ -288,7 +298,9 @@ void DisplayRSSIBar(const bool now)
 #ifdef ENABLE_FEAT_F4HWN
     int16_t rssi_dBm =
         BK4819_GetRSSI_dBm()
-
+#ifdef ENABLE_AM_FIX__
+        + ((gSetting_AM_fix && gRxVfo->Modulation == MODULATION_AM) ? AM_fix_get_gain_diff() : 0)
+#endif
         + dBmCorrTable[gRxVfo->Band];
 
     rssi_dBm = -rssi_dBm;
@@ -312,7 +324,9 @@ void DisplayRSSIBar(const bool now)
     const int16_t s0_dBm   = -gEeprom.S0_LEVEL;                    
     const int16_t rssi_dBm =
         BK4819_GetRSSI_dBm()
-
+#ifdef ENABLE_AM_FIX__
+        + ((gSetting_AM_fix && gRxVfo->Modulation == MODULATION_AM) ? AM_fix_get_gain_diff() : 0)
+#endif
         + dBmCorrTable[gRxVfo->Band];
 
     int s0_9 = gEeprom.S0_LEVEL - gEeprom.S9_LEVEL;
@@ -437,6 +451,7 @@ void UI_MAIN_TimeSlice500ms(void)
 
         if(FUNCTION_IsRx()) {
             DisplayRSSIBar(true);
+            gRedrawStats.partial++;
         }
 #ifdef ENABLE_FEAT_F4HWN   
         else if(gSetting_set_eot > 0 && RxBlinkLed == 2)
@@ -490,11 +505,67 @@ void UI_MAIN_TimeSlice500ms(void)
     }
 }
 
+static unsigned int DrawDTMFLive(char *String, unsigned int idx)
+{
+#ifdef ENABLE_FEAT_F4HWN
+    const unsigned int line = isMainOnly() ? 5 : 3;
+#else
+    const unsigned int line = 3;
+#endif
+
+    sprintf(String, "DTMF %s", gDTMF_RX_live + idx);
+    UI_PrintStringSmallNormal(String, 2, 0, line);
+    dtmfLiveLength = strlen(String);
+
+    return line;
+}
+
+void UI_MAIN_DisplayWidgets(void)
+{
+    const uint8_t dirty = gMainWidgetsDirty;
+
+    gMainWidgetsDirty = 0;
+
+    if (dirty & MAIN_WIDGET_DTMF_LIVE) {
+        char               String[22];
+        const unsigned int len = strlen(gDTMF_RX_live);
+        const unsigned int idx = (len > (17 - 5)) ? len - (17 - 5) : 0;
+
+        // repainting in place is only exact while the line already shows a
+        // DTMF string no longer than the new one, anything else needs the full pass
+        if (gScreenToDisplay != DISPLAY_MAIN ||
+            center_line != CENTER_LINE_DTMF_DEC ||
+            !gSetting_live_DTMF_decoder ||
+            5 + len - idx < dtmfLiveLength)
+        {
+            gUpdateDisplay = true;
+            return;
+        }
+
+        ST7565_BlitLine(DrawDTMFLive(String, idx));
+        gRedrawStats.partial++;
+    }
+}
+
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+// tail of the name jump prefix, drawn where the channel number goes
+static bool NameJumpLabel(char *String, unsigned int vfo_num)
+{
+    if (!gNameJumpMode || gEeprom.TX_VFO != vfo_num)
+        return false;
+
+    const unsigned int len = strlen(gNameJumpPrefix);
+    sprintf(String, "%s_", gNameJumpPrefix + (len > 4 ? len - 4 : 0));
+    return true;
+}
+#endif
+
 void UI_DisplayMain(void)
 {
     char String[22];    
 
     center_line = CENTER_LINE_NONE;    
+    gMainWidgetsDirty = 0;
 
     UI_DisplayClear();
 
@@ -755,6 +826,10 @@ void UI_DisplayMain(void)
             else
                 sprintf(String, "M%.3s", INPUTBOX_GetAscii());    
            // UI_PrintStringSmallNormal(String, x, 0, line + 1);
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+            if (gEeprom.CHANNEL_DISPLAY_MODE != MDF_NAME_FREQ && NameJumpLabel(String, vfo_num))
+                UI_PrintStringSmallNormal(String, x, 0, line + 1);
+#endif
         }
         else if (IS_FREQ_CHANNEL(gEeprom.ScreenChannel[vfo_num]))
         {     
@@ -926,6 +1001,9 @@ void UI_DisplayMain(void)
 
                             // --- 2. НОМЕР КАНАЛА (Нижняя строка, Y = line + 1, X = 2) ---
                             sprintf(String, "M%u", gEeprom.ScreenChannel[vfo_num] + 1);
+#ifdef ENABLE_CHANNEL_NAME_INDEX
+                            NameJumpLabel(String, vfo_num);
+#endif
                             if (activeTxVFO == vfo_num) {
                                 UI_PrintStringSmallBold(String, 2, 0, line + 1);   // ЖИРНЫЙ номер
                             } else {
@@ -1297,20 +1375,7 @@ void UI_DisplayMain(void)
 
                     center_line = CENTER_LINE_DTMF_DEC;
 
-                    sprintf(String, "DTMF %s", gDTMF_RX_live + idx);
-#ifdef ENABLE_FEAT_F4HWN
-                    if (isMainOnly())
-                    {
-                        UI_PrintStringSmallNormal(String, 2, 0, 5);
-                    }
-                    else
-                    {
-                        UI_PrintStringSmallNormal(String, 2, 0, 3);
-                    }
-#else
-                    UI_PrintStringSmallNormal(String, 2, 0, 3);
-
-#endif
+                    DrawDTMFLive(String, idx);
                 }
             #else
                 if (gSetting_live_DTMF_decoder && gDTMF_RX_index > 0)
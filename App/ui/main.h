@@ -21,6 +21,12 @@ enum Vfo_txtr_mode {
 
 typedef enum center_line_t center_line_t;
 
+enum {
+    MAIN_WIDGET_DTMF_LIVE = 1u << 0,
+};
+
+extern uint8_t gMainWidgetsDirty;
+
 extern center_line_t center_line;
 
 extern const int8_t dBmCorrTable[7];
@@ -30,6 +36,7 @@ void UI_DisplayAudioBar(void);
 void UI_MAIN_TimeSlice500ms(void);
 
 void UI_DisplayMain(void);
+void UI_MAIN_DisplayWidgets(void);
 
 #ifdef ENABLE_AGC_SHOW_DATA
   
@@ -15,6 +15,7 @@
 #include "../external/printf/printf.h"
 #include "../frequencies.h"
 #include "../helper/battery.h"
+#include "../helper/profile.h"
 #include "../misc.h"
 #include "../settings.h"
 
@@ -158,6 +159,9 @@ const t_menu_item MenuList[] =
     {"BatCal",      MENU_BATCAL        },   
     {"BatTyp",      MENU_BATTYP        },   
     {"Reset",       MENU_RESET         },   
+#ifdef ENABLE_PROFILER
+    {"Prof",        MENU_PROFILE       },
+#endif
 
     {"",                              0xff               }    
 };
@@ -311,7 +315,10 @@ const char gSubMenu_BAT_TXT[][8] =
 {
     "NONE",
     "VOLTAGE",
-    "PERCENT"
+    "PERCENT",
+#ifdef ENABLE_BATTERY_ESTIMATOR
+    "RUNTIME"
+#endif
 };
 
 const char gSubMenu_BATTYP[][12] =
@@ -556,13 +563,11 @@ void UI_DisplayMenu(void)
             }
             break;
 
+#ifndef ENABLE_AUDIO_BAR
         case MENU_MIC_BAR:
-            #ifdef ENABLE_AUDIO_BAR
-                strcpy(String, gSubMenu_OFF_ON[gSubMenuSelection]);
-            #else
-                strcpy(String, gSubMenu_NA);
-            #endif
+            strcpy(String, gSubMenu_NA);
             break;
+#endif
 
         case MENU_STEP: {
             uint16_t step = gStepFrequencyTable[FREQUENCY_GetStepIdxFromSortedIdx(gSubMenuSelection)];
@@ -601,10 +606,6 @@ void UI_DisplayMenu(void)
             break;
         }
 
-        case MENU_SFT_D:
-            strcpy(String, gSubMenu_SFT_D[gSubMenuSelection]);
-            break;
-
         case MENU_OFFSET:
             if (!gIsInSubMenu || gInputBoxIndex == 0)
             {
@@ -623,10 +624,6 @@ void UI_DisplayMenu(void)
             already_printed = true;
             break;
 
-        case MENU_W_N:
-            strcpy(String, gSubMenu_W_N[gSubMenuSelection]);
-            break;
-
         case MENU_SCR:
             strcpy(String, gSubMenu_SCRAMBLER[gSubMenuSelection]);
             
@@ -675,10 +672,6 @@ void UI_DisplayMenu(void)
 
             break;
 
-        case MENU_AM:
-            strcpy(String, gModulationStr[gSubMenuSelection]);
-            break;
-
         case MENU_AUTOLK:
             if (gSubMenuSelection == 0)
                 strcpy(String, gSubMenu_OFF_ON[0]);
@@ -694,36 +687,11 @@ void UI_DisplayMenu(void)
             break;
 
         case MENU_COMPAND:
-        case MENU_ABR_ON_TX_RX:
             strcpy(String, gSubMenu_RX_TX[gSubMenuSelection]);
             break;
-        case MENU_BCL:
-        case MENU_BEEP:
         case MENU_S_ADD1:
         case MENU_S_ADD2:
         case MENU_S_ADD3:
-        case MENU_STE:
-        case MENU_D_ST:
-#ifdef ENABLE_DTMF_CALLING
-        case MENU_D_DCD:
-#endif
-        case MENU_D_LIVE_DEC:
-        #ifdef ENABLE_NOAA
-            case MENU_NOAA_S:
-        #endif
-#ifndef ENABLE_FEAT_F4HWN
-        case MENU_350TX:
-        case MENU_200TX:
-        case MENU_500TX:
-#endif
-        case MENU_350EN:
-        case MENU_SCREN:
-
-#ifdef ENABLE_FEAT_F4HWN
-        #ifdef ENABLE_FEAT_F4HWN_RX_TX_TIMER   
-        case MENU_SET_TMR:
-        #endif
-#endif
             strcpy(String, gSubMenu_OFF_ON[gSubMenuSelection]);
             break;
 
@@ -789,6 +757,12 @@ void UI_DisplayMenu(void)
         }
 
         case MENU_SAVE:
+#ifdef ENABLE_ADAPTIVE_POWER_SAVE
+            if (gSubMenuSelection == BATTERY_SAVE_AUTO) {
+                strcpy(String, "AUTO");
+                break;
+            }
+#endif
             sprintf(String, gSubMenuSelection == 0 ? gSubMenu_OFF_ON[0] : "1:%u", gSubMenuSelection);
             break;
 
@@ -805,12 +779,6 @@ void UI_DisplayMenu(void)
               
             break;
 
-        #ifdef ENABLE_VOICE
-            case MENU_VOICE:
-                strcpy(String, gSubMenu_VOICE[gSubMenuSelection]);
-                break;
-        #endif
-
         case MENU_SC_REV:
             if(gSubMenuSelection == 0)
             {
@@ -855,12 +823,6 @@ void UI_DisplayMenu(void)
                 strcpy(String, "ALL");
             break;
 
-        #ifdef ENABLE_ALARM
-            case MENU_AL_MOD:
-                sprintf(String, gSubMenu_AL_MOD[gSubMenuSelection]);
-                break;
-        #endif
-
 #ifdef ENABLE_DTMF_CALLING
         case MENU_ANI_ID:
             strcpy(String, gEeprom.ANI_DTMF_ID);
@@ -875,10 +837,6 @@ void UI_DisplayMenu(void)
             break;
 
 #ifdef ENABLE_DTMF_CALLING
-        case MENU_D_RSP:
-            strcpy(String, gSubMenu_D_RSP[gSubMenuSelection]);
-            break;
-
         case MENU_D_HOLD:
             sprintf(String, "%ds", gSubMenuSelection);
             break;
@@ -891,10 +849,6 @@ void UI_DisplayMenu(void)
             strcpy(String, gSubMenu_PTT_ID[gSubMenuSelection]);
             break;
 
-        case MENU_BAT_TXT:
-            strcpy(String, gSubMenu_BAT_TXT[gSubMenuSelection]);
-            break;
-
 #ifdef ENABLE_DTMF_CALLING
         case MENU_D_LIST:
             gIsDtmfContactValid = DTMF_GetContact((int)gSubMenuSelection - 1, Contact);
@@ -905,13 +859,6 @@ void UI_DisplayMenu(void)
             break;
 #endif
 
-        case MENU_PONMSG:
-            strcpy(String, gSubMenu_PONMSG[gSubMenuSelection]);
-            break;
-
-        case MENU_ROGER:
-            strcpy(String, gSubMenu_ROGER[gSubMenuSelection]);
-            break;
 case MENU_VOL:
 #ifdef ENABLE_FEAT_F4HWN
             {
@@ -977,9 +924,16 @@ case MENU_VOL:
             break;
         }
 
-        case MENU_BATTYP:
-            strcpy(String, gSubMenu_BATTYP[gSubMenuSelection]);
+#ifdef ENABLE_PROFILER
+        case MENU_PROFILE:
+            sprintf(String, "%s\nMIN %uus\nAVG %uus\nMAX %uus\nOVR %u",
+                gProfileTaskNames[gSubMenuSelection],
+                gProfile.task[gSubMenuSelection].min_us,
+                PROFILE_GetAverage_us(gSubMenuSelection),
+                gProfile.task[gSubMenuSelection].max_us,
+                gProfile.task[gSubMenuSelection].overruns);
             break;
+#endif
 
         case MENU_F1SHRT:
         case MENU_F1LONG:
@@ -1016,11 +970,6 @@ case MENU_VOL:
         //     strcpy(String, gSubMenu_SET_PTT[gSubMenuSelection]);
         //     break; // PTTDEL
 
-        case MENU_SET_TOT:
-        case MENU_SET_EOT:
-            strcpy(String, gSubMenu_SET_TOT[gSubMenuSelection]);   
-            break;
-
         case MENU_SET_CTR:
             #ifdef ENABLE_FEAT_F4HWN_CTR
                 sprintf(String, "%d", gSubMenuSelection);
@@ -1051,21 +1000,6 @@ case MENU_VOL:
             }
             break;
 
-        case MENU_SET_LCK:
-            strcpy(String, gSubMenu_SET_LCK[gSubMenuSelection]);
-            break;
-
-        case MENU_SET_MET:
-        case MENU_SET_GUI:
-            strcpy(String, gSubMenu_SET_MET[gSubMenuSelection]);   
-            break;
-
-        #ifdef ENABLE_FEAT_F4HWN_NARROWER
-            case MENU_SET_NFM:
-                strcpy(String, gSubMenu_SET_NFM[gSubMenuSelection]);
-                break;
-        #endif
-
         #ifdef ENABLE_FEAT_F4HWN_VOL
             case MENU_SET_VOL:
                 if(gSubMenuSelection == 0)
@@ -1091,6 +1025,12 @@ case MENU_VOL:
         #endif
 #endif
 
+        default: {
+            const MENU_Setting_t *pSetting = MENU_GetSetting(UI_MENU_GetCurrentMenuId());
+            if (pSetting != NULL && pSetting->pNames != NULL)
+                strcpy(String, pSetting->pNames + gSubMenuSelection * pSetting->NameSize);
+            break;
+        }
     }
 
     if(gaugeLine != 0)
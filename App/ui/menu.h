@@ -137,7 +137,10 @@ enum
     MENU_F2SHRT,
     MENU_F2LONG,
     MENU_MLONG,
-    MENU_BATTYP
+    MENU_BATTYP,
+#ifdef ENABLE_PROFILER
+    MENU_PROFILE,
+#endif
 };
 
 extern const uint8_t FIRST_HIDDEN_MENU_ITEM;
@@ -183,7 +186,11 @@ extern const char        gSubMenu_ROGER[3][6];
 extern const char        gSubMenu_RESET[2][4];
 extern const char* const gSubMenu_F_LOCK[F_LOCK_LEN];
 extern const char        gSubMenu_RX_TX[4][6];
-extern const char        gSubMenu_BAT_TXT[3][8];
+#ifdef ENABLE_BATTERY_ESTIMATOR
+    extern const char    gSubMenu_BAT_TXT[4][8];
+#else
+    extern const char    gSubMenu_BAT_TXT[3][8];
+#endif
 extern const char        gSubMenu_BATTYP[5][12];
 extern const char        gSubMenu_SCRAMBLER[11][7];
 
@@ -210,6 +210,11 @@ void UI_DisplayStatus()
     // 8. БАТАРЕЯ (Твой оригинал)
     if (gSetting_battery_text == 1) {
         sprintf(str, "%u.%02u", gBatteryVoltageAverage / 100, gBatteryVoltageAverage % 100);
+#ifdef ENABLE_BATTERY_ESTIMATOR
+    } else if (gSetting_battery_text == 3) {
+        const uint16_t runtime = BATTERY_GetRuntime_min();
+        sprintf(str, "%uh%02u", runtime / 60, runtime % 60);
+#endif
     } else {
         sprintf(str, "%u%%", BATTERY_VoltsToPercent(gBatteryVoltageAverage));
     }
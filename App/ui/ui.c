@@ -9,6 +9,7 @@
     #include "app/fm.h"
 #endif
 #include "driver/keyboard.h"
+#include "helper/profile.h"
 #include "misc.h"
 #ifdef ENABLE_AIRCOPY
     #include "ui/aircopy.h"
@@ -33,6 +34,8 @@ bool              gAskToSave;
 
 bool              gAskToDelete;
 
+GUI_RedrawStats_t gRedrawStats;
+
 void (*UI_DisplayFunctions[])(void) = {
     [DISPLAY_MAIN] = &UI_DisplayMain,
     [DISPLAY_MENU] = &UI_DisplayMenu,
@@ -51,7 +54,10 @@ void GUI_DisplayScreen(void)
 {
     if (gScreenToDisplay != DISPLAY_INVALID)
     {
+        PROFILE_BEGIN(PROFILE_DISPLAY);
+        gRedrawStats.full++;
         UI_DisplayFunctions[gScreenToDisplay]();
+        PROFILE_END(PROFILE_DISPLAY);
     }
 }
 
@@ -87,3 +93,17 @@ void GUI_SelectNextDisplay(GUI_DisplayType_t Display)
     gScreenToDisplay = Display;
     gUpdateDisplay   = true;
 }
+
+void GUI_TimeSlice500ms(void)
+{
+    static bool secondHalf;
+
+    secondHalf = !secondHalf;
+    if (secondHalf)
+        return;
+
+    gRedrawStats.fullPerSecond    = gRedrawStats.full;
+    gRedrawStats.partialPerSecond = gRedrawStats.partial;
+    gRedrawStats.full             = 0;
+    gRedrawStats.partial          = 0;
+}
@@ -26,6 +26,16 @@ enum GUI_DisplayType_t
 
 typedef enum GUI_DisplayType_t GUI_DisplayType_t;
 
+// full/partial count the current second, the rates hold the last whole one
+typedef struct {
+    uint16_t full;
+    uint16_t partial;
+    uint16_t fullPerSecond;
+    uint16_t partialPerSecond;
+} GUI_RedrawStats_t;
+
+extern GUI_RedrawStats_t gRedrawStats;
+
 extern GUI_DisplayType_t gScreenToDisplay;
 
 extern GUI_DisplayType_t gRequestDisplayScreen;
@@ -40,4 +50,6 @@ void GUI_DisplayScreen(void);
 
 void GUI_SelectNextDisplay(GUI_DisplayType_t Display);
 
+void GUI_TimeSlice500ms(void);
+
 #endif
@@ -0,0 +1,235 @@
+// Checks the band/TX interval table in frequencies.c against the per-lock
+// switch it replaced, so the two cannot drift apart.
+
+#include <stdio.h>
+
+#include "frequencies.h"
+#include "misc.h"
+#include "settings.h"
+
+static unsigned long checked;
+static unsigned long failures;
+
+// the lookup as it was before the interval table
+static FREQUENCY_Band_t ref_GetBand(uint32_t Frequency)
+{
+    for (int32_t band = BAND_N_ELEM - 1; band >= 0; band--)
+        if (Frequency >= frequencyBandTable[band].lower)
+            return (FREQUENCY_Band_t)band;
+
+    return BAND1_50MHz;
+}
+
+static int32_t ref_RX_freq_check(const uint32_t Frequency)
+{
+    if (Frequency < frequencyBandTable[0].lower || Frequency > frequencyBandTable[BAND_N_ELEM - 1].upper)
+        return -1;
+
+    if (Frequency >= BX4819_band1.upper && Frequency < BX4819_band2.lower)
+        return -1;
+
+    return 0;
+}
+
+static int32_t ref_TX_freq_check(const uint32_t Frequency)
+{
+    if (ref_RX_freq_check(Frequency) != 0)
+        return -1;
+
+    switch (gSetting_F_LOCK)
+    {
+        case F_LOCK_DEF:
+            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < frequencyBandTable[BAND3_137MHz].upper)
+                return 0;
+            if (Frequency >= frequencyBandTable[BAND4_174MHz].lower && Frequency < frequencyBandTable[BAND4_174MHz].upper)
+            #ifndef ENABLE_FEAT_F4HWN
+                if (gSetting_200TX)
+            #endif
+                    return 0;
+            if (Frequency >= frequencyBandTable[BAND5_350MHz].lower && Frequency < frequencyBandTable[BAND5_350MHz].upper)
+            #ifndef ENABLE_FEAT_F4HWN
+                if (gSetting_350TX && gSetting_350EN)
+            #else
+                if (gSetting_350EN)
+            #endif
+                    return 0;
+            if (Frequency >= frequencyBandTable[BAND6_400MHz].lower && Frequency < frequencyBandTable[BAND6_400MHz].upper)
+                return 0;
+            if (Frequency >= frequencyBandTable[BAND7_470MHz].lower && Frequency <= 60000000)
+            #ifndef ENABLE_FEAT_F4HWN
+                if (gSetting_500TX)
+            #endif
+                    return 0;
+            break;
+
+        case F_LOCK_FCC:
+            if (Frequency >= 14400000 && Frequency < 14800000)
+                return 0;
+            if (Frequency >= 42000000 && Frequency < 45000000)
+                return 0;
+            break;
+
+        case F_LOCK_CE:
+            if (Frequency >= 14400000 && Frequency < 14600000)
+                return 0;
+            if (Frequency >= 43000000 && Frequency < 44000000)
+                return 0;
+            break;
+
+        case F_LOCK_GB:
+            if (Frequency >= 14400000 && Frequency < 14800000)
+                return 0;
+            if (Frequency >= 43000000 && Frequency < 44000000)
+                return 0;
+            break;
+
+        case F_LOCK_430:
+            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < 17400000)
+                return 0;
+            if (Frequency >= 40000000 && Frequency < 43000000)
+                return 0;
+            break;
+
+        case F_LOCK_438:
+            if (Frequency >= frequencyBandTable[BAND3_137MHz].lower && Frequency < 17400000)
+                return 0;
+            if (Frequency >= 40000000 && Frequency < 43800000)
+                return 0;
+            break;
+
+#ifdef ENABLE_FEAT_F4HWN_PMR
+        case F_LOCK_PMR:
+            if (Frequency >= 44600625 && Frequency <= 44619375)
+                return 0;
+            break;
+#endif
+
+#ifdef ENABLE_FEAT_F4HWN_GMRS_FRS_MURS
+        case F_LOCK_GMRS_FRS_MURS:
+            if ((Frequency >= 46255000 && Frequency <= 46272500) ||
+                (Frequency >= 46755000 && Frequency <= 46772500))
+                return 0;
+            if (Frequency == 15182000 ||
+                Frequency == 15188000 ||
+                Frequency == 15194000 ||
+                Frequency == 15457000 ||
+                Frequency == 15460000)
+                return 0;
+            break;
+#endif
+
+#ifdef ENABLE_FEAT_F4HWN_CA
+        case F_LOCK_CA:
+            if (Frequency >= 14400000 && Frequency < 14800000)
+                return 0;
+            if (Frequency >= 43000000 && Frequency < 45000000)
+                return 0;
+            break;
+#endif
+
+        case F_LOCK_ALL:
+            break;
+
+        case F_LOCK_NONE:
+            for (uint32_t i = 0; i < BAND_N_ELEM; i++)
+                if (Frequency >= frequencyBandTable[i].lower && Frequency < frequencyBandTable[i].upper)
+                    return 0;
+            break;
+    }
+
+    return -1;
+}
+
+// every edge the old switch tests against, a few Hz either side is checked
+static const uint32_t edges[] =
+{
+    14400000, 14600000, 14800000, 17400000, 40000000, 42000000, 43000000,
+    43800000, 44000000, 45000000, 60000000,
+    44600625, 44619375, 46255000, 46272500, 46755000, 46772500,
+    15182000, 15188000, 15194000, 15457000, 15460000,
+};
+
+static void CheckFrequency(const uint32_t Frequency)
+{
+    checked++;
+
+    if (ref_TX_freq_check(Frequency) != TX_freq_check(Frequency))
+    {
+        if (failures++ < 20)
+            printf("TX mismatch at %u, lock %u, 350EN %d: expected %d\n",
+                   Frequency, gSetting_F_LOCK, gSetting_350EN, ref_TX_freq_check(Frequency));
+    }
+
+    if (ref_RX_freq_check(Frequency) != RX_freq_check(Frequency) ||
+        ref_GetBand(Frequency) != FREQUENCY_GetBand(Frequency))
+    {
+        if (failures++ < 20)
+            printf("RX/band mismatch at %u: expected %d/%d\n",
+                   Frequency, ref_RX_freq_check(Frequency), ref_GetBand(Frequency));
+    }
+}
+
+static void CheckAround(const uint32_t Frequency)
+{
+    for (uint32_t f = Frequency - 2; f <= Frequency + 2; f++)
+        CheckFrequency(f);
+}
+
+static void CheckAllFrequencies(const bool grid)
+{
+    for (unsigned int i = 0; i < ARRAY_SIZE(edges); i++)
+        CheckAround(edges[i]);
+
+    for (unsigned int i = 0; i < BAND_N_ELEM; i++)
+    {
+        CheckAround(frequencyBandTable[i].lower);
+        CheckAround(frequencyBandTable[i].upper);
+    }
+
+    CheckAround(BX4819_band1.lower);
+    CheckAround(BX4819_band1.upper);
+    CheckAround(BX4819_band2.lower);
+    CheckAround(BX4819_band2.upper);
+
+    CheckFrequency(0);
+    CheckFrequency(UINT32_MAX);
+
+    if (!grid)
+        return;
+
+    // a 1 kHz grid plus the 8.33 and 9 kHz steps
+    for (uint32_t f = 0; f <= 135000000; f += 100)
+        CheckFrequency(f);
+    for (uint32_t f = 0; f <= 135000000; f += 833)
+        CheckFrequency(f);
+    for (uint32_t f = 0; f <= 135000000; f += 900)
+        CheckFrequency(f);
+}
+
+int main(void)
+{
+    // out of range locks must refuse TX
+    for (unsigned int lock = 0; lock < F_LOCK_LEN + 2; lock++)
+    {
+        gSetting_F_LOCK = lock;
+        CheckAllFrequencies(true);
+    }
+
+    // the extra settings only matter for F_LOCK_DEF, and only flip whole bands
+    gSetting_F_LOCK = F_LOCK_DEF;
+    for (unsigned int settings = 0; settings < 16; settings++)
+    {
+#ifndef ENABLE_FEAT_F4HWN
+        gSetting_200TX = settings & 1;
+        gSetting_350TX = settings & 2;
+        gSetting_500TX = settings & 4;
+#endif
+        gSetting_350EN = settings & 8;
+
+        CheckAllFrequencies(false);
+    }
+
+    printf("%lu checks, %lu failures\n", checked, failures);
+
+    return failures != 0;
+}
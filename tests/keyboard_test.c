@@ -0,0 +1,324 @@
+// Drives the interrupt-driven keypad scanner in driver/keyboard.c with a
+// simulated key matrix, one TIM14 tick per millisecond.
+
+#include <stdio.h>
+
+#include "driver/gpio.h"
+#include "driver/keyboard.h"
+#include "misc.h"
+#include "py32f071_ll_tim.h"
+
+static unsigned int failures;
+
+#define CHECK(cond, ...) \
+    do { \
+        if (!(cond)) { \
+            failures++; \
+            printf("%s:%d: ", __func__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+        } \
+    } while (0)
+
+// where each key sits in the matrix, side keys pull a row with no column driven
+static const struct {
+    KEY_Code_t Key;
+    int8_t     Column;
+    uint8_t    Row;
+} layout[] = {
+    {KEY_SIDE1, -1, 0},
+    {KEY_MENU,   0, 0},
+    {KEY_1,      0, 1},
+    {KEY_UP,     1, 0},
+    {KEY_5,      1, 2},
+    {KEY_9,      2, 3},
+};
+
+static uint32_t   outputs;
+static KEY_Code_t heldKey = KEY_INVALID;
+static bool       bouncing;
+static unsigned   now_ms;
+
+void LL_GPIO_SetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    if (GPIOx == GPIOB)
+        outputs |= PinMask;
+}
+
+void LL_GPIO_ResetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    if (GPIOx == GPIOB)
+        outputs &= ~PinMask;
+}
+
+void LL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    if (GPIOx == GPIOB)
+        outputs ^= PinMask;
+}
+
+uint32_t LL_GPIO_ReadInputPort(GPIO_TypeDef *GPIOx)
+{
+    uint32_t Rows = LL_GPIO_PIN_15 | LL_GPIO_PIN_14 | LL_GPIO_PIN_13 | LL_GPIO_PIN_12;
+
+    // a bouncing contact is closed on every other millisecond
+    if (GPIOx != GPIOB || heldKey == KEY_INVALID || (bouncing && (now_ms & 1)))
+        return Rows;
+
+    for (unsigned int i = 0; i < ARRAY_SIZE(layout); i++)
+    {
+        if (layout[i].Key != heldKey)
+            continue;
+        if (layout[i].Column < 0 || !(outputs & (LL_GPIO_PIN_6 >> layout[i].Column)))
+            Rows &= ~(LL_GPIO_PIN_15 >> layout[i].Row);
+    }
+
+    return Rows;
+}
+
+uint32_t LL_GPIO_IsInputPinSet(GPIO_TypeDef *GPIOx, uint32_t PinMask)
+{
+    return (LL_GPIO_ReadInputPort(GPIOx) & PinMask) != 0;
+}
+
+typedef struct {
+    unsigned      Time_ms;
+    KEY_Message_t Message;
+} Event_t;
+
+static Event_t      events[64];
+static unsigned int eventCount;
+
+// runs the scanner, the main loop reads the queue after every tick unless stalled
+static void Run(unsigned int ms, bool stalled)
+{
+    for (unsigned int i = 0; i < ms; i++, now_ms++)
+    {
+        TIM14_IRQHandler();
+
+        KEY_Message_t Message;
+        while (!stalled && KEYBOARD_GetEvent(&Message))
+        {
+            if (eventCount < ARRAY_SIZE(events))
+                events[eventCount++] = (Event_t){now_ms, Message};
+        }
+    }
+}
+
+static void Reset(void)
+{
+    heldKey  = KEY_INVALID;
+    bouncing = false;
+    KEYBOARD_SetOverride(false, KEY_INVALID);
+    Run(100, false);
+    eventCount = 0;
+}
+
+static bool IsEvent(unsigned int i, KEY_Code_t Key, KEY_Event_t Event)
+{
+    return i < eventCount && events[i].Message.Key == Key && events[i].Message.Event == Event;
+}
+
+static unsigned int CountEvents(KEY_Event_t Event)
+{
+    unsigned int n = 0;
+
+    for (unsigned int i = 0; i < eventCount; i++)
+        n += events[i].Message.Event == Event;
+
+    return n;
+}
+
+static void TestGlitchIgnored(void)
+{
+    Reset();
+
+    // three scans are one short of the 20 ms debounce
+    heldKey = KEY_5;
+    Run(15, false);
+    heldKey = KEY_INVALID;
+    Run(100, false);
+
+    CHECK(eventCount == 0, "%u events from a 15 ms glitch", eventCount);
+}
+
+static void TestBounceDebounced(void)
+{
+    Reset();
+
+    heldKey  = KEY_5;
+    bouncing = true;
+    Run(20, false);
+    bouncing = false;
+    Run(200, false);
+
+    bouncing = true;
+    Run(20, false);
+    heldKey  = KEY_INVALID;
+    bouncing = false;
+    Run(100, false);
+
+    CHECK(eventCount == 2, "%u events from one bouncing press", eventCount);
+    CHECK(IsEvent(0, KEY_5, KEY_EVENT_PRESS), "no press first");
+    CHECK(IsEvent(1, KEY_5, KEY_EVENT_RELEASE), "no release second");
+}
+
+static void TestLongPress(void)
+{
+    Reset();
+
+    const unsigned Start_ms = now_ms;
+    heldKey = KEY_5;
+    Run(1000, false);
+    heldKey = KEY_INVALID;
+    Run(100, false);
+
+    CHECK(eventCount == 3, "%u events from a long press", eventCount);
+    CHECK(IsEvent(0, KEY_5, KEY_EVENT_PRESS), "no press first");
+    CHECK(IsEvent(1, KEY_5, KEY_EVENT_HOLD), "no hold second");
+    CHECK(IsEvent(2, KEY_5, KEY_EVENT_RELEASE), "no release third");
+
+    // both are due within a 5 ms scan of their nominal time
+    const unsigned Press_ms = events[0].Time_ms - Start_ms;
+    const unsigned Hold_ms  = events[1].Time_ms - Start_ms;
+    CHECK(Press_ms + 5 >= key_debounce_10ms * 10u && Press_ms <= key_debounce_10ms * 10u + 5,
+          "press after %u ms", Press_ms);
+    CHECK(Hold_ms + 5 >= key_repeat_delay_10ms * 10u && Hold_ms <= key_repeat_delay_10ms * 10u + 5,
+          "hold after %u ms", Hold_ms);
+}
+
+static void TestRepeat(void)
+{
+    Reset();
+
+    heldKey = KEY_UP;
+    Run(1000, false);
+    heldKey = KEY_INVALID;
+    Run(100, false);
+
+    CHECK(IsEvent(0, KEY_UP, KEY_EVENT_PRESS), "no press first");
+    CHECK(IsEvent(1, KEY_UP, KEY_EVENT_HOLD), "no hold second");
+    CHECK(IsEvent(eventCount - 1, KEY_UP, KEY_EVENT_RELEASE), "no release last");
+
+    const unsigned int Repeats = CountEvents(KEY_EVENT_REPEAT);
+    CHECK(Repeats >= 6 && Repeats <= 8, "%u repeats in 600 ms", Repeats);
+
+    for (unsigned int i = 3; i + 1 < eventCount; i++)
+    {
+        const unsigned Gap_ms = events[i].Time_ms - events[i - 1].Time_ms;
+        CHECK(Gap_ms == key_repeat_10ms * 10u, "repeat %u after %u ms", i, Gap_ms);
+    }
+}
+
+static void TestSideKey(void)
+{
+    Reset();
+
+    heldKey = KEY_SIDE1;
+    Run(100, false);
+    heldKey = KEY_INVALID;
+    Run(100, false);
+
+    CHECK(eventCount == 2, "%u events from a side key", eventCount);
+    CHECK(IsEvent(0, KEY_SIDE1, KEY_EVENT_PRESS), "no side key press");
+    CHECK(IsEvent(1, KEY_SIDE1, KEY_EVENT_RELEASE), "no side key release");
+}
+
+static void TestQueueOverflow(void)
+{
+    Reset();
+
+    // 40 events against a 16 entry ring: the oldest 15 stay, the rest drop
+    for (unsigned int i = 0; i < 20; i++)
+    {
+        heldKey = KEY_1;
+        Run(50, true);
+        heldKey = KEY_INVALID;
+        Run(50, true);
+    }
+    Run(1, false);
+
+    CHECK(eventCount == 15, "%u events kept from a full queue", eventCount);
+    for (unsigned int i = 0; i < eventCount; i++)
+        CHECK(IsEvent(i, KEY_1, i % 2 ? KEY_EVENT_RELEASE : KEY_EVENT_PRESS), "event %u out of order", i);
+
+    // and the queue works again once drained
+    eventCount = 0;
+    heldKey = KEY_9;
+    Run(50, false);
+    CHECK(eventCount == 1 && IsEvent(0, KEY_9, KEY_EVENT_PRESS), "no press after an overflow");
+}
+
+static void TestRepeatNotQueued(void)
+{
+    Reset();
+
+    heldKey = KEY_UP;
+    Run(2000, true);
+    Run(1, false);
+
+    CHECK(eventCount == 2, "%u events queued behind a stalled loop", eventCount);
+    CHECK(IsEvent(0, KEY_UP, KEY_EVENT_PRESS), "no press first");
+    CHECK(IsEvent(1, KEY_UP, KEY_EVENT_HOLD), "no hold second");
+
+    // a running loop gets its repeats back
+    eventCount = 0;
+    Run(200, false);
+    CHECK(CountEvents(KEY_EVENT_REPEAT) >= 2, "no repeats after the loop resumed");
+}
+
+static void TestOverride(void)
+{
+    Reset();
+
+    KEYBOARD_SetOverride(true, KEY_MENU);
+    Run(100, false);
+    CHECK(eventCount == 1 && IsEvent(0, KEY_MENU, KEY_EVENT_PRESS), "no press from the override");
+
+    // the real keypad is ignored while overridden
+    heldKey = KEY_5;
+    Run(100, false);
+    CHECK(eventCount == 1, "%u events while overridden", eventCount);
+
+    KEYBOARD_SetOverride(true, KEY_INVALID);
+    Run(100, false);
+    CHECK(eventCount == 2 && IsEvent(1, KEY_MENU, KEY_EVENT_RELEASE), "no release from the override");
+
+    KEYBOARD_SetOverride(false, KEY_INVALID);
+    Run(100, false);
+    CHECK(eventCount == 3 && IsEvent(2, KEY_5, KEY_EVENT_PRESS), "keypad not back after the override");
+}
+
+static void TestPoll(void)
+{
+    Reset();
+
+    heldKey = KEY_5;
+    Run(10, true);
+    CHECK(KEYBOARD_Poll() == KEY_5, "poll does not see the held key");
+
+    // events queued while a loop polled the keypad itself are dropped
+    Run(100, true);
+    CHECK(KEYBOARD_Poll() == KEY_5, "poll lost the held key");
+    Run(1, false);
+    CHECK(eventCount == 0, "%u stale events after a poll", eventCount);
+}
+
+int main(void)
+{
+    KEYBOARD_Init();
+
+    TestGlitchIgnored();
+    TestBounceDebounced();
+    TestLongPress();
+    TestRepeat();
+    TestSideKey();
+    TestQueueOverflow();
+    TestRepeatNotQueued();
+    TestOverride();
+    TestPoll();
+
+    printf("%u failures\n", failures);
+
+    return failures != 0;
+}
@@ -0,0 +1,154 @@
+// Walks the MenuSettings[] table of app/menu.c: every item's limits must
+// fit its field and names, and both limits must survive a save of the
+// records the item names followed by a reload from flash.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "app/dtmf.h"
+#include "app/menu.h"
+#include "driver/bk1080.h"
+#include "driver/bk4819.h"
+#include "driver/py25q16.h"
+#include "helper/battery.h"
+#include "radio.h"
+#include "settings.h"
+#ifdef ENABLE_FMRADIO
+    #include "app/fm.h"
+#endif
+
+static unsigned int failures;
+
+#define CHECK(cond, ...) \
+    do { \
+        if (!(cond)) { \
+            failures++; \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+        } \
+    } while (0)
+
+// the settings sectors and the volume record, erased
+static uint8_t flash[0x011000];
+
+void PY25Q16_ReadBuffer(uint32_t Address, void *pBuffer, uint32_t Size)
+{
+    memcpy(pBuffer, flash + Address, Size);
+}
+
+void PY25Q16_ReadRecord(uint32_t Address, void *pBuffer, uint32_t Size)
+{
+    PY25Q16_ReadBuffer(Address, pBuffer, Size);
+}
+
+void PY25Q16_WriteBuffer(uint32_t Address, const void *pBuffer, uint32_t Size, bool Append)
+{
+    memcpy(flash + Address, pBuffer, Size);
+}
+
+// what settings.c and app/menu.c reach beyond the settings themselves
+VFO_Info_t    *gTxVfo = &gEeprom.VfoInfo[0];
+const char     gModulationStr[MODULATION_UKNOWN][4];
+uint16_t       gBatteryCalibration[6];
+char           gDTMF_RX_live[20];
+uint8_t        gDTMF_RX_live_timeout;
+#ifdef ENABLE_FMRADIO
+uint16_t       gFM_Channels[MAX_FM_CHANNELS];
+int            FM_ConfigureChannelState(void) { return 0; }
+#endif
+
+uint16_t BK1080_GetFreqLoLimit(uint8_t band) { return 6400; }
+uint16_t BK1080_GetFreqHiLimit(uint8_t band) { return 10800; }
+void     BK4819_WriteRegister(BK4819_REGISTER_t Register, uint16_t Data) {}
+void     BK4819_DisableScramble(void) {}
+void     BK4819_EnableScramble(uint8_t Type) {}
+void     BK4819_DisableDTMF(void) {}
+bool     DTMF_ValidateCodes(char *pCode, const unsigned int size) { return false; }
+void     RADIO_SetupRegisters(bool switchToForeground) {}
+void     RADIO_SetTxParameters(void) {}
+
+static int32_t Load(const MENU_Setting_t *pSetting)
+{
+    switch (pSetting->Size) {
+        case 1:  return *(const uint8_t *)pSetting->pValue;
+        case 2:  return *(const uint16_t *)pSetting->pValue;
+        default: return *(const uint32_t *)pSetting->pValue;
+    }
+}
+
+static void Store(const MENU_Setting_t *pSetting, int32_t Value)
+{
+    switch (pSetting->Size) {
+        case 1:  *(uint8_t *)pSetting->pValue  = Value; break;
+        case 2:  *(uint16_t *)pSetting->pValue = Value; break;
+        default: *(uint32_t *)pSetting->pValue = Value; break;
+    }
+}
+
+static void CheckLimits(const MENU_Setting_t *pSetting)
+{
+    int32_t Min;
+    int32_t Max;
+
+    CHECK(MENU_GetLimits(pSetting->Id, &Min, &Max) == 0 && Min == pSetting->Min && Max == pSetting->Max,
+          "menu %u: MENU_GetLimits does not report the table limits", pSetting->Id);
+    CHECK(Min <= Max, "menu %u: limits %d..%d", pSetting->Id, Min, Max);
+    CHECK(Min >= 0 && (pSetting->Size >= 4 || Max < (1 << (8 * pSetting->Size))),
+          "menu %u: limits %d..%d do not fit %u bytes", pSetting->Id, Min, Max, pSetting->Size);
+
+    for (int32_t i = Min; pSetting->pNames != NULL && i <= Max; i++) {
+        const char *pName = pSetting->pNames + i * pSetting->NameSize;
+        CHECK(memchr(pName, 0, pSetting->NameSize) != NULL, "menu %u: name %d is not terminated", pSetting->Id, i);
+    }
+
+    // per channel values must point into the VFO the menu edits through gTxVfo
+    const uint8_t *pVfo = (const uint8_t *)&gEeprom.VfoInfo[0];
+    const uint8_t *pValue = pSetting->pValue;
+    CHECK(pSetting->Records != 0 || (pValue >= pVfo && pValue + pSetting->Size <= pVfo + sizeof(VFO_Info_t)),
+          "menu %u: per channel value outside VfoInfo[0]", pSetting->Id);
+}
+
+static void CheckRecords(const MENU_Setting_t *pSetting)
+{
+    const int32_t Limits[] = {pSetting->Min, pSetting->Max};
+
+    if (pSetting->Records == 0)
+        return;
+
+    for (unsigned int i = 0; i < 2; i++) {
+        const int32_t Value = Limits[i];
+
+        // start from a flash image that holds every other setting as it is now
+        SETTINGS_SaveSettingsRecords(SETTINGS_RECORD_ALL);
+
+        Store(pSetting, Value);
+        SETTINGS_SaveSettingsRecords(pSetting->Records);
+        Store(pSetting, Value == pSetting->Max ? pSetting->Min : pSetting->Max);
+        SETTINGS_InitEEPROM();
+
+        CHECK(Load(pSetting) == Value, "menu %u: %d saved with records 0x%02x reloads as %d",
+              pSetting->Id, Value, pSetting->Records, Load(pSetting));
+    }
+}
+
+int main(void)
+{
+    unsigned int items = 0;
+
+    memset(flash, 0xff, sizeof(flash));
+    SETTINGS_InitEEPROM();
+
+    for (unsigned int id = 0; id < 256; id++) {
+        const MENU_Setting_t *pSetting = MENU_GetSetting(id);
+        if (pSetting == NULL)
+            continue;
+
+        CheckLimits(pSetting);
+        CheckRecords(pSetting);
+        items++;
+    }
+
+    printf("%u menu settings, %u failures\n", items, failures);
+
+    return items == 0 || failures != 0;
+}
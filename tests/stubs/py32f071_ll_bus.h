@@ -0,0 +1,10 @@
+// Host stand-in for the PY32 LL bus driver, clock gating is a no-op.
+
+#ifndef PY32F071_LL_BUS_H
+#define PY32F071_LL_BUS_H
+
+#define LL_APB1_GRP2_PERIPH_TIM14       0u
+
+#define LL_APB1_GRP2_EnableClock(Periphs)   ((void)(Periphs))
+
+#endif
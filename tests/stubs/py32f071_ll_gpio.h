@@ -0,0 +1,40 @@
+// Host stand-in for the PY32 LL GPIO driver: ports are fake addresses and
+// the pin functions are implemented by the test that needs them.
+
+#ifndef PY32F071_LL_GPIO_H
+#define PY32F071_LL_GPIO_H
+
+#include <stdint.h>
+
+typedef struct GPIO_TypeDef GPIO_TypeDef;
+
+#define IOPORT_BASE     0x00000000u
+#define GPIOA           ((GPIO_TypeDef *)(IOPORT_BASE + 0x0000u))
+#define GPIOB           ((GPIO_TypeDef *)(IOPORT_BASE + 0x0400u))
+#define GPIOC           ((GPIO_TypeDef *)(IOPORT_BASE + 0x0800u))
+#define GPIOF           ((GPIO_TypeDef *)(IOPORT_BASE + 0x1400u))
+
+#define LL_GPIO_PIN_0   (1u << 0)
+#define LL_GPIO_PIN_1   (1u << 1)
+#define LL_GPIO_PIN_2   (1u << 2)
+#define LL_GPIO_PIN_3   (1u << 3)
+#define LL_GPIO_PIN_4   (1u << 4)
+#define LL_GPIO_PIN_5   (1u << 5)
+#define LL_GPIO_PIN_6   (1u << 6)
+#define LL_GPIO_PIN_7   (1u << 7)
+#define LL_GPIO_PIN_8   (1u << 8)
+#define LL_GPIO_PIN_9   (1u << 9)
+#define LL_GPIO_PIN_10  (1u << 10)
+#define LL_GPIO_PIN_11  (1u << 11)
+#define LL_GPIO_PIN_12  (1u << 12)
+#define LL_GPIO_PIN_13  (1u << 13)
+#define LL_GPIO_PIN_14  (1u << 14)
+#define LL_GPIO_PIN_15  (1u << 15)
+
+void     LL_GPIO_SetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask);
+void     LL_GPIO_ResetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask);
+void     LL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint32_t PinMask);
+uint32_t LL_GPIO_IsInputPinSet(GPIO_TypeDef *GPIOx, uint32_t PinMask);
+uint32_t LL_GPIO_ReadInputPort(GPIO_TypeDef *GPIOx);
+
+#endif
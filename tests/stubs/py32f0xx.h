@@ -0,0 +1,8 @@
+// Host stand-in for the PY32 device header.
+
+#ifndef PY32F0XX_H
+#define PY32F0XX_H
+
+void NVIC_SystemReset(void);
+
+#endif
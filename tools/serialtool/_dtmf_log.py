@@ -0,0 +1,110 @@
+# Copyright (c) 2025 muzkr
+#
+#   https://github.com/muzkr
+#
+# Licensed under the MIT License (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at the root of this repository.
+#
+#     Unless required by applicable law or agreed to in writing, software
+#     distributed under the License is distributed on an "AS IS" BASIS,
+#     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#     See the License for the specific language governing permissions and
+#     limitations under the License.
+#
+
+"""
+Read the received DTMF log of a firmware built with ENABLE_DTMF_LOG
+"""
+
+from serial import Serial
+from time import monotonic, sleep
+import msg as mm
+
+MSG_READ_DTMF_LOG = 0x053F
+MSG_READ_DTMF_LOG_RESP = 0x0540
+
+RECORD_SIZE = 32
+RECORD_OFFSET = 12
+FLAG_ANI = 1 << 0
+RESP_TIMEOUT = 1.0
+
+
+class DtmfLogReader:
+
+    def __init__(self, ser: Serial, limit: int | None):
+        self._ser = ser
+        self._limit = limit
+        self._index = 0
+        self._rx_buf = bytearray(256)
+        self._msg_buf = bytearray()
+        self._header = False
+
+    def loop(self) -> bool:
+
+        if self._limit is not None and self._index >= self._limit:
+            return False
+
+        msg = mm.Msg.make(MSG_READ_DTMF_LOG, 4)
+        msg.set_hw_LE(4, self._index)
+        resp = self._request(msg)
+        if resp is None:
+            return False
+
+        if not self._header:
+            self._header = True
+            print("Next sequence: {}, events dropped: {}".format(resp.get_hw_LE(4), resp.get_hw_LE(6)))
+
+        count = resp.buf[8]
+        for i in range(count):
+            if self._limit is not None and self._index >= self._limit:
+                break
+            _print_record(resp.buf, RECORD_OFFSET + i * RECORD_SIZE)
+            self._index += 1
+
+        if count == 0:
+            print("{} records".format(self._index))
+            return False
+
+        return True
+
+    def _request(self, msg: mm.Msg) -> mm.Msg | None:
+
+        self._ser.write(mm.make_packet(msg.buf))
+        self._ser.flush()
+
+        deadline = monotonic() + RESP_TIMEOUT
+        while monotonic() < deadline:
+            self._rx()
+            resp = mm.fetch(self._msg_buf)
+            if resp is not None and resp.get_msg_type() == MSG_READ_DTMF_LOG_RESP:
+                return resp
+            if resp is None:
+                sleep(0.001)
+
+        print("No response to message {:04x}".format(msg.get_msg_type()))
+        return None
+
+    def _rx(self):
+
+        while True:
+            len1 = self._ser.readinto(self._rx_buf)
+            if len1 > 0:
+                self._msg_buf.extend(memoryview(self._rx_buf)[:len1])
+            if len1 < len(self._rx_buf):
+                break
+
+
+def _print_record(buf: bytes, off: int):
+
+    seq = mm._get_hw_LE(buf, off)
+    length = buf[off + 2]
+    flags = buf[off + 3]
+    time_10ms = mm._get_word_LE(buf, off + 4)
+    digits = bytes(buf[off + 8 : off + 8 + length]).decode("ascii", "replace")
+
+    print(
+        "{:5d}  {:>10.2f} s  {:<24} {}".format(
+            seq, time_10ms / 100, digits, "ANI" if flags & FLAG_ANI else ""
+        ).rstrip()
+    )
@@ -0,0 +1,238 @@
+# Copyright (c) 2025 muzkr
+#
+#   https://github.com/muzkr
+#
+# Licensed under the MIT License (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at the root of this repository.
+#
+#     Unless required by applicable law or agreed to in writing, software
+#     distributed under the License is distributed on an "AS IS" BASIS,
+#     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#     See the License for the specific language governing permissions and
+#     limitations under the License.
+#
+
+"""
+Key replay against a firmware built with ENABLE_PROFILER
+
+Script lines, '#' starts a comment:
+
+    KEY <name> [hold_ms] [gap_ms]   press and release a key
+    WAIT <ms>                       let the radio run
+    CAPTURE <name>                  save the LCD as <name>.bin, compare with the reference if given
+
+Key names: 0-9 MENU UP DOWN EXIT STAR F SIDE1 SIDE2
+"""
+
+from serial import Serial
+from time import monotonic, sleep
+import os
+import msg as mm
+
+MSG_INJECT_KEY = 0x0539
+MSG_INJECT_KEY_RESP = 0x053A
+MSG_LCD_PAGE = 0x053B
+MSG_LCD_PAGE_RESP = 0x053C
+
+KEYS = {str(i): i for i in range(10)}
+KEYS.update(MENU=10, UP=11, DOWN=12, EXIT=13, STAR=14, F=15, SIDE2=17, SIDE1=18)
+
+LCD_PAGES = 8
+LCD_WIDTH = 128
+NO_LATENCY = 0xFFFFFFFF
+RESP_TIMEOUT = 1.0
+SETTLE_TIME = 0.2
+
+
+class Step:
+    def __init__(self, line_no: int, op: str, args: list):
+        self.line_no = line_no
+        self.op = op
+        self.args = args
+
+
+def parse_script(file: str) -> list:
+
+    steps = []
+    with open(file) as fd:
+        for line_no, line in enumerate(fd, 1):
+            words = line.split("#", 1)[0].split()
+            if not words:
+                continue
+
+            op = words[0].upper()
+            args = words[1:]
+            if op == "KEY":
+                if not 1 <= len(args) <= 3 or args[0].upper() not in KEYS:
+                    raise ValueError("line {}: bad KEY step".format(line_no))
+                args = [KEYS[args[0].upper()]] + [int(a) for a in args[1:]]
+            elif op == "WAIT":
+                if len(args) != 1:
+                    raise ValueError("line {}: bad WAIT step".format(line_no))
+                args = [int(args[0])]
+            elif op == "CAPTURE":
+                if len(args) != 1:
+                    raise ValueError("line {}: bad CAPTURE step".format(line_no))
+            else:
+                raise ValueError("line {}: unknown step '{}'".format(line_no, words[0]))
+
+            steps.append(Step(line_no, op, args))
+
+    return steps
+
+
+class KeyReplay:
+
+    def __init__(self, ser: Serial, steps: list, out_dir: str, ref_dir: str | None):
+        self._ser = ser
+        self._steps = steps
+        self._out_dir = out_dir
+        self._ref_dir = ref_dir
+        self._index = 0
+        self._rx_buf = bytearray(256)
+        self._msg_buf = bytearray()
+        self.failures = 0
+
+    def loop(self) -> bool:
+
+        if self._index >= len(self._steps):
+            print("{} steps, {} failures".format(len(self._steps), self.failures))
+            return False
+
+        step = self._steps[self._index]
+        self._index += 1
+
+        match step.op:
+            case "KEY":
+                self._key(step)
+            case "WAIT":
+                sleep(step.args[0] / 1000)
+            case "CAPTURE":
+                self._capture(step)
+
+        return True
+
+    def _key(self, step: Step):
+
+        key = step.args[0]
+        hold = step.args[1] if len(step.args) > 1 else 100
+        gap = step.args[2] if len(step.args) > 2 else 100
+
+        resp = self._inject(0xFF, 0, 0)
+        if resp is None:
+            return
+        seq = (resp.buf[6] + 1) & 0xFF
+
+        resp = self._inject(key, min(255, hold // 10), min(255, gap // 10))
+        if resp is None:
+            return
+        if not resp.buf[4]:
+            self._fail(step, "key rejected")
+            return
+
+        # wait for the queue to drain, then for the release to be drawn
+        deadline = monotonic() + RESP_TIMEOUT + (hold + gap) / 1000
+        while resp is not None and resp.buf[5] and monotonic() < deadline:
+            sleep(0.02)
+            resp = self._inject(0xFF, 0, 0)
+        sleep(SETTLE_TIME)
+        resp = self._inject(0xFF, 0, 0)
+        if resp is None:
+            return
+
+        if resp.buf[6] != seq or resp.buf[7] != key:
+            self._fail(step, "key not handled")
+            return
+
+        press = resp.get_word_LE(12)
+        release = resp.get_word_LE(16)
+        print(
+            "{:4d}: KEY {:<5} press {:>8} release {:>8}".format(
+                step.line_no, _key_name(key), _latency(press), _latency(release)
+            )
+        )
+
+    def _inject(self, key: int, hold: int, gap: int) -> mm.Msg | None:
+
+        msg = mm.Msg.make(MSG_INJECT_KEY, 4)
+        msg.buf[4] = key
+        msg.buf[5] = hold
+        msg.buf[6] = gap
+        return self._request(msg, MSG_INJECT_KEY_RESP)
+
+    def _capture(self, step: Step):
+
+        name = step.args[0]
+        frame = bytearray()
+        for page in range(LCD_PAGES):
+            msg = mm.Msg.make(MSG_LCD_PAGE, 4)
+            msg.buf[4] = page
+            resp = self._request(msg, MSG_LCD_PAGE_RESP)
+            if resp is None or resp.buf[4] != page:
+                self._fail(step, "no LCD page {}".format(page))
+                return
+            frame.extend(resp.buf[12 : 12 + LCD_WIDTH])
+
+        file = os.path.join(self._out_dir, name + ".bin")
+        with open(file, "wb") as fd:
+            fd.write(frame)
+
+        result = "saved"
+        if self._ref_dir:
+            ref_file = os.path.join(self._ref_dir, name + ".bin")
+            if not os.path.exists(ref_file):
+                result = "no reference"
+            else:
+                with open(ref_file, "rb") as fd:
+                    ref = fd.read()
+                if ref == frame:
+                    result = "match"
+                else:
+                    diff = [p for p in range(LCD_PAGES) if ref[p * LCD_WIDTH : (p + 1) * LCD_WIDTH] != frame[p * LCD_WIDTH : (p + 1) * LCD_WIDTH]]
+                    self._fail(step, "{} differs in pages {}".format(name, diff))
+                    return
+
+        print("{:4d}: CAPTURE {} crc {:04x} {}".format(step.line_no, name, mm.calc_CRC(frame, 0, len(frame)), result))
+
+    def _request(self, msg: mm.Msg, resp_type: int) -> mm.Msg | None:
+
+        self._ser.write(mm.make_packet(msg.buf))
+        self._ser.flush()
+
+        deadline = monotonic() + RESP_TIMEOUT
+        while monotonic() < deadline:
+            self._rx()
+            resp = mm.fetch(self._msg_buf)
+            if resp is not None and resp.get_msg_type() == resp_type:
+                return resp
+            if resp is None:
+                sleep(0.001)
+
+        print("No response to message {:04x}".format(msg.get_msg_type()))
+        self.failures += 1
+        return None
+
+    def _rx(self):
+
+        while True:
+            len1 = self._ser.readinto(self._rx_buf)
+            if len1 > 0:
+                self._msg_buf.extend(memoryview(self._rx_buf)[:len1])
+            if len1 < len(self._rx_buf):
+                break
+
+    def _fail(self, step: Step, reason: str):
+        print("{:4d}: {} FAILED: {}".format(step.line_no, step.op, reason))
+        self.failures += 1
+
+
+def _key_name(key: int) -> str:
+    for name, code in KEYS.items():
+        if code == key:
+            return name
+    return str(key)
+
+
+def _latency(us: int) -> str:
+    return "-" if us == NO_LATENCY else "{} us".format(us)
@@ -25,6 +25,8 @@ import os
 import _prog as pp
 import _dump as dd
 import _restore as rr
+import _replay as kr
+import _dtmf_log as dl
 
 
 def load_image(file: str) -> bytes:
@@ -105,6 +107,45 @@ def main_restore(args, ser: serial.Serial):
         sleep(0)
 
 
+def main_replay(args, ser: serial.Serial):
+
+    try:
+        steps = kr.parse_script(args.file)
+    except Exception as e:
+        print("Cannot load script '{}': {}".format(args.file, e))
+        return
+
+    os.makedirs(args.out, exist_ok=True)
+    print("Script loaded: {}, {} steps".format(args.file, len(steps)))
+
+    quit_flag = False
+
+    def quit_handler(sig, frame):
+        nonlocal quit_flag
+        quit_flag = True
+
+    signal.signal(signal.SIGINT, quit_handler)
+
+    replay = kr.KeyReplay(ser, steps, args.out, args.ref)
+    while (not quit_flag) and replay.loop():
+        sleep(0)
+
+
+def main_dtmf_log(args, ser: serial.Serial):
+
+    quit_flag = False
+
+    def quit_handler(sig, frame):
+        nonlocal quit_flag
+        quit_flag = True
+
+    signal.signal(signal.SIGINT, quit_handler)
+
+    reader = dl.DtmfLogReader(ser, args.count)
+    while (not quit_flag) and reader.loop():
+        sleep(0)
+
+
 def main_flash(args, ser: serial.Serial):
 
     bl_ver: str = args.bl_ver
@@ -146,6 +187,8 @@ def main():
     # serialtool.py .. flash [--bl-ver <ver>] <file>
     # serialtool.py .. dump {--config | --calib [| --all]} file
     # serialtool.py .. restore {--config | --calib [| --all]} file
+    # serialtool.py .. replay [--out <dir>] [--ref <dir>] script
+    # serialtool.py .. dtmf-log [--count <n>]
     ap = argparse.ArgumentParser(description="UV-K5 V2 serial tool")
 
     # TODO: have to add option to each of subcommands ??
@@ -198,6 +241,28 @@ def main():
     )
     ap_restore.add_argument("file", help="input dump file")
 
+    ap_replay = sp.add_parser(
+        "replay", help="replay a key script, report key latency and capture the LCD"
+    )
+    ap_replay.add_argument(
+        "--port", "-p", help="serial port, eg., '/dev/ttyUSB0'", required=True
+    )
+    ap_replay.add_argument(
+        "--out", help="directory for captured frames. Default '.'", default="."
+    )
+    ap_replay.add_argument(
+        "--ref", help="directory of reference frames to compare against", required=False
+    )
+    ap_replay.add_argument("file", help="key script")
+
+    ap_dtmf_log = sp.add_parser("dtmf-log", help="print received DTMF sequences, newest first")
+    ap_dtmf_log.add_argument(
+        "--port", "-p", help="serial port, eg., '/dev/ttyUSB0'", required=True
+    )
+    ap_dtmf_log.add_argument(
+        "--count", "-n", type=int, help="number of records. Default all", required=False
+    )
+
     args = ap.parse_args()
     port: str = args.port
     sub_name: str = args.subcommand
@@ -218,6 +283,10 @@ def main():
             main_dump(args, ser)
         case "restore":
             main_restore(args, ser)
+        case "replay":
+            main_replay(args, ser)
+        case "dtmf-log":
+            main_dtmf_log(args, ser)
 
     ser.close()
     print("Quit")
@@ -0,0 +1,422 @@
+#!/usr/bin/env python3
+
+# Flash/RAM/stack report for a firmware build, with budget checks.
+#
+# Reads the GNU ld map file written next to the .elf (-Wl,-Map), and the
+# .ci call graphs / .su frame sizes GCC emits with -fcallgraph-info=su.
+#
+#   size_report.py map BUILD_DIR [--map FILE]   report one build
+#   size_report.py presets [NAME ...]           configure, build and report
+#                                               every preset in CMakePresets.json
+#       --features                              also rebuild with each enabled
+#                                               ENABLE_* turned off and report
+#                                               what the feature costs
+#
+# Budgets default to the FLASH and RAM regions of the linker script as
+# recorded in the map. The stack estimate is checked against the RAM left
+# above .bss and the heap. The exit status is 1 when any budget is exceeded.
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(__file__), "..", ".."))
+
+# entry points for the stack estimate; interrupts may nest on top of Main
+THREAD_ROOTS = ("Reset_Handler", "main", "Main")
+ISR_SUFFIXES = ("_IRQHandler", "_Handler")
+
+SECTION_RE = re.compile(r"^(\S+)\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)(?:\s+load address\s+(0x[0-9a-f]+))?", re.I)
+INPUT_RE = re.compile(r"^\s+(\S+)?\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(\S.*)$", re.I)
+REGION_RE = re.compile(r"^(\S+)\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)", re.I)
+
+
+class Region:
+    def __init__(self, name: str, origin: int, length: int):
+        self.name = name
+        self.origin = origin
+        self.length = length
+
+    def holds(self, addr: int) -> bool:
+        return self.origin <= addr < self.origin + self.length
+
+
+class MapFile:
+    """Input sections of a GNU ld map, split into kept and discarded."""
+
+    def __init__(self, file: str):
+        self.regions = {}
+        self.kept = []          # (output section, vma, lma, size, object, input section)
+        self.discarded = []     # (input section, size, object)
+        self.out_sections = {}  # name -> (vma, lma, size)
+        self._parse(file)
+
+    def _parse(self, file: str):
+        part = None
+        out = None
+        pending = None
+        pending_out = None
+        with open(file, errors="replace") as fd:
+            for line in fd:
+                line = line.rstrip("\n")
+                if line.startswith("Discarded input sections"):
+                    part = "discarded"
+                    continue
+                if line.startswith("Memory Configuration"):
+                    part = "memory"
+                    continue
+                if line.startswith("Linker script and memory map"):
+                    part = "map"
+                    continue
+                if part == "memory":
+                    m = REGION_RE.match(line)
+                    if m and m.group(1) not in ("Name", "*default*"):
+                        self.regions[m.group(1)] = Region(m.group(1), int(m.group(2), 16), int(m.group(3), 16))
+                    continue
+                if part not in ("discarded", "map") or not line.strip():
+                    continue
+
+                # long section names wrap the address onto the next line
+                if pending_out is not None:
+                    line = pending_out + line
+                    pending_out = None
+                elif pending is not None:
+                    line = " " + pending + line
+                    pending = None
+                elif line.startswith(" ") and len(line.split()) == 1 and line.lstrip().startswith((".", "COMMON")):
+                    pending = line.strip()
+                    continue
+
+                if part == "map" and not line.startswith(" "):
+                    m = SECTION_RE.match(line)
+                    if m:
+                        out = m.group(1)
+                        vma = int(m.group(2), 16)
+                        lma = int(m.group(4), 16) if m.group(4) else vma
+                        self.out_sections[out] = (vma, lma, int(m.group(3), 16))
+                    elif len(line.split()) == 1:
+                        out = None
+                        pending_out = line.strip()
+                    continue
+
+                m = INPUT_RE.match(line)
+                if not m or m.group(1) is None or m.group(1).startswith("*"):
+                    continue
+                size = int(m.group(3), 16)
+                if size == 0:
+                    continue
+                obj = m.group(4).strip()
+                if part == "discarded":
+                    self.discarded.append((m.group(1), size, obj))
+                elif out is not None and out in self.out_sections:
+                    vma0, lma0, _ = self.out_sections[out]
+                    vma = int(m.group(2), 16)
+                    self.kept.append((out, vma, lma0 + (vma - vma0), size, obj, m.group(1)))
+
+    def region_of(self, addr: int) -> str | None:
+        for r in self.regions.values():
+            if r.holds(addr):
+                return r.name
+        return None
+
+
+def module_name(obj: str) -> str:
+    """CMakeFiles/x.dir/App/driver/st7565.c.obj -> App/driver/st7565.c"""
+    m = re.search(r"\.dir/(.+?)(\.obj|\.o)$", obj)
+    if m:
+        return m.group(1)
+    m = re.search(r"([^/\\]+\.a)\(", obj)
+    if m:
+        return m.group(1)
+    return os.path.basename(obj)
+
+
+def usage(mp: MapFile) -> dict:
+    """Per-module flash and RAM bytes, and totals, from the kept sections."""
+    modules = {}
+    total = {"flash": 0, "ram": 0, "reserve": 0}
+    for out, vma, lma, size, obj, _ in mp.kept:
+        flash = mp.region_of(lma) == "FLASH"
+        ram = mp.region_of(vma) == "RAM"
+        mod = modules.setdefault(module_name(obj), {"flash": 0, "ram": 0})
+        if flash:
+            mod["flash"] += size
+            total["flash"] += size
+        if ram:
+            mod["ram"] += size
+            total["ram"] += size
+
+    # the heap/stack reserve has no input sections, only its output size
+    if "._user_heap_stack" in mp.out_sections:
+        total["reserve"] = mp.out_sections["._user_heap_stack"][2]
+    return {"modules": modules, "total": total}
+
+
+def discarded_by_module(mp: MapFile) -> dict:
+    gc = {}
+    for sec, size, obj in mp.discarded:
+        if not sec.startswith((".text", ".rodata", ".data", ".bss")):
+            continue
+        gc[module_name(obj)] = gc.get(module_name(obj), 0) + size
+    return gc
+
+
+def parse_callgraphs(build_dir: str):
+    """Frame sizes and call edges from .ci files, falling back to .su."""
+    frames = {}
+    edges = {}
+    dynamic = set()
+    have_ci = False
+    node_re = re.compile(r'node:\s*\{\s*title:\s*"([^"]+)"\s*label:\s*"([^"]*)"')
+    edge_re = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]+)"\s*targetname:\s*"([^"]+)"')
+    bytes_re = re.compile(r"(\d+) bytes \(([^)]*)\)")
+
+    for dirpath, _, files in os.walk(build_dir):
+        for f in files:
+            path = os.path.join(dirpath, f)
+            if f.endswith(".ci"):
+                have_ci = True
+                text = open(path, errors="replace").read()
+                for title, label in node_re.findall(text):
+                    m = bytes_re.search(label)
+                    if m:
+                        frames[title] = max(frames.get(title, 0), int(m.group(1)))
+                        if "dynamic" in m.group(2) and "bounded" not in m.group(2):
+                            dynamic.add(title)
+                for src, dst in edge_re.findall(text):
+                    edges.setdefault(src, set()).add(dst)
+            elif f.endswith(".su"):
+                for line in open(path, errors="replace"):
+                    parts = line.rstrip("\n").split("\t")
+                    if len(parts) < 3:
+                        continue
+                    name = parts[0].rsplit(":", 1)[-1]
+                    frames.setdefault(name, int(parts[1]))
+                    if "dynamic" in parts[2] and "bounded" not in parts[2]:
+                        dynamic.add(name)
+
+    return frames, edges, dynamic, have_ci
+
+
+def worst_path(root: str, frames: dict, edges: dict):
+    """Deepest stack below root; recursion is cut at the first repeat."""
+    memo = {}
+    recursive = set()
+
+    def walk(fn: str, stack: tuple):
+        if fn in stack:
+            recursive.add(fn)
+            return 0, []
+        if fn in memo:
+            return memo[fn]
+        best, best_path = 0, []
+        for callee in edges.get(fn, ()):
+            depth, path = walk(callee, stack + (fn,))
+            if depth > best:
+                best, best_path = depth, path
+        result = (frames.get(fn, 0) + best, [fn] + best_path)
+        memo[fn] = result
+        return result
+
+    depth, path = walk(root, ())
+    return depth, path, recursive
+
+
+def stack_estimate(build_dir: str) -> dict | None:
+    frames, edges, dynamic, have_ci = parse_callgraphs(build_dir)
+    if not frames:
+        return None
+
+    result = {"call_graph": have_ci, "dynamic": sorted(dynamic), "recursive": set()}
+    if not have_ci:
+        top = sorted(frames.items(), key=lambda kv: -kv[1])[:10]
+        result["frames"] = top
+        result["thread"] = (top[0][1], [top[0][0]]) if top else (0, [])
+        result["isrs"] = []
+        result["total"] = result["thread"][0]
+        return result
+
+    thread = (0, [])
+    for root in THREAD_ROOTS:
+        if root in frames:
+            depth, path, rec = worst_path(root, frames, edges)
+            result["recursive"] |= rec
+            if depth > thread[0]:
+                thread = (depth, path)
+
+    isrs = []
+    for fn in frames:
+        if fn.endswith(ISR_SUFFIXES) and fn not in THREAD_ROOTS:
+            depth, path, rec = worst_path(fn, frames, edges)
+            result["recursive"] |= rec
+            isrs.append((depth, path))
+    isrs.sort(key=lambda x: -x[0])
+
+    # every interrupt may preempt the one below it, plus 32 bytes of
+    # hardware-stacked context per level
+    result["thread"] = thread
+    result["isrs"] = isrs
+    result["total"] = thread[0] + sum(d + 32 for d, _ in isrs)
+    return result
+
+
+def report(build_dir: str, map_file: str, args) -> bool:
+    mp = MapFile(map_file)
+    use = usage(mp)
+    flash_region = mp.regions.get("FLASH")
+    ram_region = mp.regions.get("RAM")
+    flash_budget = args.flash_budget or (flash_region.length if flash_region else 0)
+    ram_budget = args.ram_budget or (ram_region.length if ram_region else 0)
+    total = use["total"]
+    ok = True
+
+    print(f"== {map_file}")
+    print(f"{'module':<52} {'flash':>8} {'ram':>7}")
+    rows = sorted(use["modules"].items(), key=lambda kv: -(kv[1]["flash"] + kv[1]["ram"]))
+    for name, m in rows[: args.top]:
+        print(f"{name:<52} {m['flash']:>8} {m['ram']:>7}")
+    if len(rows) > args.top:
+        rest = rows[args.top:]
+        print(f"{'(' + str(len(rest)) + ' more)':<52} {sum(m['flash'] for _, m in rest):>8} {sum(m['ram'] for _, m in rest):>7}")
+
+    gc = discarded_by_module(mp)
+    if gc and args.gc:
+        print(f"\n{'removed by --gc-sections':<52} {'bytes':>8}")
+        for name, size in sorted(gc.items(), key=lambda kv: -kv[1])[: args.top]:
+            print(f"{name:<52} {size:>8}")
+
+    ram_used = total["ram"] + total["reserve"]
+    print()
+    print(f"flash  {total['flash']:>7} / {flash_budget:<7} {flash_budget - total['flash']:>7} free")
+    print(f"ram    {ram_used:>7} / {ram_budget:<7} {ram_budget - ram_used:>7} free"
+          f"  (data+bss {total['ram']}, heap+stack reserve {total['reserve']})")
+    if flash_budget and total["flash"] > flash_budget:
+        print("FAIL: flash budget exceeded")
+        ok = False
+    if ram_budget and ram_used > ram_budget:
+        print("FAIL: RAM budget exceeded")
+        ok = False
+
+    st = stack_estimate(build_dir)
+    if st is None:
+        print("stack  no .ci/.su files found, build with -fcallgraph-info=su")
+        return ok
+
+    stack_room = (ram_region.length if ram_region else 0) - total["ram"] - (total["reserve"] - args.min_stack)
+    if st["call_graph"]:
+        depth, path = st["thread"]
+        print(f"stack  {st['total']:>7} / {stack_room:<7} worst case, thread {depth} via {' > '.join(path[:6])}")
+        for d, p in st["isrs"][:5]:
+            print(f"       {d:>7} {p[0]}" + (f" > {' > '.join(p[1:4])}" if len(p) > 1 else ""))
+    else:
+        print(f"stack  no call graph, largest frames:")
+        for name, size in st["frames"]:
+            print(f"       {size:>7} {name}")
+    if st["recursive"]:
+        print(f"       recursion not bounded: {', '.join(sorted(st['recursive']))}")
+    if st["dynamic"]:
+        print(f"       dynamic frames not bounded: {', '.join(st['dynamic'][:8])}")
+    if stack_room and st["total"] > stack_room:
+        print("FAIL: stack estimate exceeds free RAM")
+        ok = False
+    return ok
+
+
+def load_presets() -> dict:
+    text = open(os.path.join(ROOT, "CMakePresets.json")).read()
+    text = re.sub(r"//[^\n\"]*$", "", text, flags=re.M)
+    presets = {p["name"]: p for p in json.loads(text)["configurePresets"]}
+
+    def resolve(p: dict) -> dict:
+        cache = {}
+        parents = p.get("inherits", [])
+        for parent in [parents] if isinstance(parents, str) else parents:
+            cache.update(resolve(presets[parent]))
+        cache.update(p.get("cacheVariables", {}))
+        return cache
+
+    return {name: resolve(p) for name, p in presets.items() if not p.get("hidden")}
+
+
+def build(preset: str, build_dir: str, extra: list) -> str | None:
+    cmd = ["cmake", "--preset", preset, "-B", build_dir] + extra
+    if subprocess.run(cmd, cwd=ROOT).returncode != 0:
+        return None
+    if subprocess.run(["cmake", "--build", build_dir, "-j"], cwd=ROOT).returncode != 0:
+        return None
+    maps = [f for f in os.listdir(build_dir) if f.endswith(".map")]
+    return os.path.join(build_dir, maps[0]) if maps else None
+
+
+def cmd_map(args) -> int:
+    map_file = args.map
+    if map_file is None:
+        maps = [f for f in os.listdir(args.build_dir) if f.endswith(".map")]
+        if not maps:
+            print(f"no .map file in {args.build_dir}", file=sys.stderr)
+            return 1
+        map_file = os.path.join(args.build_dir, maps[0])
+    return 0 if report(args.build_dir, map_file, args) else 1
+
+
+def cmd_presets(args) -> int:
+    presets = load_presets()
+    names = args.names or list(presets)
+    ok = True
+    for name in names:
+        if name not in presets:
+            print(f"unknown preset {name}", file=sys.stderr)
+            return 1
+        build_dir = os.path.join(ROOT, "build", name)
+        map_file = build(name, build_dir, [])
+        if map_file is None:
+            print(f"FAIL: preset {name} did not build")
+            ok = False
+            continue
+        ok &= report(build_dir, map_file, args)
+
+        if not args.features:
+            continue
+        base = usage(MapFile(map_file))["total"]
+        print(f"\n{'feature (cost when enabled)':<44} {'flash':>8} {'ram':>7}")
+        for flag, value in sorted(presets[name].items()):
+            if not flag.startswith("ENABLE_") or value is not True:
+                continue
+            off_dir = os.path.join(ROOT, "build", f"{name}-no-{flag}")
+            off_map = build(name, off_dir, [f"-D{flag}=OFF"])
+            if off_map is None:
+                print(f"{flag:<44} {'(no build)':>8}")
+                continue
+            off = usage(MapFile(off_map))["total"]
+            print(f"{flag:<44} {base['flash'] - off['flash']:>8} {base['ram'] - off['ram']:>7}")
+    return 0 if ok else 1
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="firmware flash/RAM/stack report")
+    ap.add_argument("--flash-budget", type=int, default=0, help="bytes, default: FLASH region length")
+    ap.add_argument("--ram-budget", type=int, default=0, help="bytes, default: RAM region length")
+    ap.add_argument("--min-stack", type=int, default=0x400, help="_Min_Stack_Size of the linker script")
+    ap.add_argument("--top", type=int, default=25, help="modules to list")
+    ap.add_argument("--gc", action="store_true", help="list what --gc-sections removed per module")
+    sub = ap.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("map", help="report an existing build")
+    p.add_argument("build_dir")
+    p.add_argument("--map", help="map file, default: the .map in BUILD_DIR")
+    p.set_defaults(func=cmd_map)
+
+    p = sub.add_parser("presets", help="build and report presets")
+    p.add_argument("names", nargs="*", help="presets to build, default: all")
+    p.add_argument("--features", action="store_true", help="measure each enabled ENABLE_* option")
+    p.set_defaults(func=cmd_presets)
+
+    args = ap.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
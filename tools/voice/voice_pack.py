@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+
+# Voice prompt packer for the SPI flash clip region.
+#
+# Clip index tables live at 0x14c000 (Chinese) and 0x14c800 (English), one
+# 8-byte {offset, size} entry per voice ID, data at 0x14d000 + offset.
+# Stock clips are 8-bit A-law at 8 kHz. Packed clips are 4-bit IMA ADPCM
+# (low nibble first, predictor and step index start at 0 for every clip)
+# and carry bit 31 in their size word; App/driver/voice.c decodes both.
+#
+#   voice_pack.py pack  FLASH_IN FLASH_OUT   re-encode all A-law clips
+#   voice_pack.py check FLASH_IN [--packed FLASH_OUT]
+#                                           round-trip every clip, report SNR
+#   voice_pack.py wav   IN.wav OUT.bin       encode an 8 kHz mono wav
+
+import argparse
+import math
+import struct
+import sys
+import wave
+
+INDEX_ADDRS = (0x14C000, 0x14C800)
+DATA_ADDR = 0x14D000
+DATA_MAX = 0x0B0000
+CLIP_MAX = 0x019000
+VOICE_ID_END = 0x4B
+ADPCM_FLAG = 0x80000000
+
+STEPS = (
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+)
+INDEX_ADJ = (-1, -1, -1, -1, 2, 4, 6, 8)
+
+
+def alaw_to_pcm(a: int) -> int:
+    a ^= 0x55
+    t = (a & 0x0F) << 4
+    seg = (a & 0x70) >> 4
+    if seg == 0:
+        t += 8
+    elif seg == 1:
+        t += 0x108
+    else:
+        t = (t + 0x108) << (seg - 1)
+    return t if a & 0x80 else -t
+
+
+def to_dac(pcm: int) -> int:
+    return (pcm + 32768) >> 4
+
+
+class Adpcm:
+    def __init__(self):
+        self.predictor = 0
+        self.index = 0
+
+    def decode(self, nibble: int) -> int:
+        step = STEPS[self.index]
+        diff = step >> 3
+        if nibble & 4:
+            diff += step
+        if nibble & 2:
+            diff += step >> 1
+        if nibble & 1:
+            diff += step >> 2
+        p = self.predictor - diff if nibble & 8 else self.predictor + diff
+        self.predictor = max(-32768, min(32767, p))
+        self.index = max(0, min(88, self.index + INDEX_ADJ[nibble & 7]))
+        return self.predictor
+
+    def encode(self, sample: int) -> int:
+        step = STEPS[self.index]
+        diff = sample - self.predictor
+        nibble = 0
+        if diff < 0:
+            nibble = 8
+            diff = -diff
+        if diff >= step:
+            nibble |= 4
+            diff -= step
+        if diff >= step >> 1:
+            nibble |= 2
+            diff -= step >> 1
+        if diff >= step >> 2:
+            nibble |= 1
+        # track the decoder exactly so both ends stay in lock-step
+        self.decode(nibble)
+        return nibble
+
+
+def encode_adpcm(pcm: list) -> bytes:
+    if len(pcm) & 1:
+        pcm = pcm + [pcm[-1] if pcm else 0]
+    enc = Adpcm()
+    out = bytearray()
+    for i in range(0, len(pcm), 2):
+        lo = enc.encode(pcm[i])
+        hi = enc.encode(pcm[i + 1])
+        out.append(lo | (hi << 4))
+    return bytes(out)
+
+
+def decode_adpcm(data: bytes) -> list:
+    dec = Adpcm()
+    pcm = []
+    for b in data:
+        pcm.append(dec.decode(b & 0x0F))
+        pcm.append(dec.decode(b >> 4))
+    return pcm
+
+
+def snr_db(ref: list, test: list) -> float:
+    sig = sum(x * x for x in ref)
+    err = sum((x - y) ** 2 for x, y in zip(ref, test))
+    if err == 0:
+        return math.inf
+    if sig == 0:
+        return -math.inf
+    return 10 * math.log10(sig / err)
+
+
+def read_clips(flash: bytes):
+    """Yield (table, voice_id, offset, size, is_adpcm) for every valid clip."""
+    for table, base in enumerate(INDEX_ADDRS):
+        for vid in range(VOICE_ID_END):
+            off, size = struct.unpack_from("<II", flash, base + 8 * vid)
+            adpcm = bool(size & ADPCM_FLAG)
+            size &= ~ADPCM_FLAG
+            if off > DATA_MAX or size > CLIP_MAX or size == 0:
+                continue
+            yield table, vid, off, size, adpcm
+
+
+def clip_pcm(flash: bytes, off: int, size: int) -> list:
+    data = flash[DATA_ADDR + off:DATA_ADDR + off + size]
+    return [alaw_to_pcm(b) for b in data]
+
+
+def cmd_pack(args) -> int:
+    flash = bytearray(open(args.flash_in, "rb").read())
+    clips = {}
+    entries = []
+    old_end = 0
+    for table, vid, off, size, adpcm in read_clips(flash):
+        if adpcm:
+            print(f"table {table} clip {vid:#04x} already ADPCM", file=sys.stderr)
+            return 1
+        # tables share clips by offset, keep them shared
+        if off not in clips:
+            clips[off] = encode_adpcm(clip_pcm(flash, off, size))
+        entries.append((table, vid, off))
+        old_end = max(old_end, off + size)
+
+    region = bytearray()
+    new_off = {}
+    for off in sorted(clips):
+        new_off[off] = len(region)
+        region += clips[off]
+        region += b"\x00" * (-len(region) % 4)
+
+    flash[DATA_ADDR:DATA_ADDR + old_end] = b"\xff" * old_end
+    flash[DATA_ADDR:DATA_ADDR + len(region)] = region
+    for table, vid, off in entries:
+        struct.pack_into("<II", flash, INDEX_ADDRS[table] + 8 * vid,
+                         new_off[off], len(clips[off]) | ADPCM_FLAG)
+
+    open(args.flash_out, "wb").write(flash)
+    print(f"clip region {old_end} -> {len(region)} bytes ({len(clips)} clips)")
+    return 0
+
+
+def cmd_check(args) -> int:
+    flash = open(args.flash_in, "rb").read()
+    packed = open(args.packed, "rb").read() if args.packed else None
+    worst = math.inf
+    count = 0
+    for table, vid, off, size, adpcm in read_clips(flash):
+        if adpcm:
+            continue
+        pcm = clip_pcm(flash, off, size)
+        if packed is None:
+            data = encode_adpcm(pcm)
+        else:
+            poff, psize = struct.unpack_from("<II", packed, INDEX_ADDRS[table] + 8 * vid)
+            if psize != ((size + 1) // 2) | ADPCM_FLAG:
+                print(f"table {table} clip {vid:#04x}: bad packed entry {poff:#x} {psize:#x}")
+                return 1
+            data = packed[DATA_ADDR + poff:DATA_ADDR + poff + (size + 1) // 2]
+        # compare what the DAC would output for both encodings
+        ref = [to_dac(x) - 0x800 for x in pcm]
+        out = [to_dac(x) - 0x800 for x in decode_adpcm(data)[:size]]
+        snr = snr_db(ref, out)
+        worst = min(worst, snr)
+        count += 1
+        if args.verbose:
+            print(f"table {table} clip {vid:#04x}: {size} -> {len(data)} bytes, SNR {snr:.1f} dB")
+    print(f"{count} clips, worst SNR {worst:.1f} dB")
+    return 0 if worst >= args.min_snr else 1
+
+
+def cmd_wav(args) -> int:
+    with wave.open(args.wav_in, "rb") as w:
+        if w.getnchannels() != 1 or w.getsampwidth() != 2 or w.getframerate() != 8000:
+            print("need 8 kHz mono 16-bit wav", file=sys.stderr)
+            return 1
+        raw = w.readframes(w.getnframes())
+    pcm = list(struct.unpack(f"<{len(raw) // 2}h", raw))
+    data = encode_adpcm(pcm)
+    if len(data) > CLIP_MAX:
+        print("clip too long", file=sys.stderr)
+        return 1
+    open(args.bin_out, "wb").write(data)
+    snr = snr_db(pcm, decode_adpcm(data)[:len(pcm)])
+    print(f"{len(pcm)} samples -> {len(data)} bytes, size word {len(data) | ADPCM_FLAG:#010x}, SNR {snr:.1f} dB")
+    return 0
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser(description="voice prompt ADPCM packer")
+    sub = ap.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("pack", help="re-encode A-law clips of a flash dump as ADPCM")
+    p.add_argument("flash_in")
+    p.add_argument("flash_out")
+    p.set_defaults(func=cmd_pack)
+
+    p = sub.add_parser("check", help="round-trip A-law clips and compare decoded PCM")
+    p.add_argument("flash_in")
+    p.add_argument("--packed", help="compare against this packed image instead of re-encoding")
+    p.add_argument("--min-snr", type=float, default=20.0)
+    p.add_argument("-v", "--verbose", action="store_true")
+    p.set_defaults(func=cmd_check)
+
+    p = sub.add_parser("wav", help="encode an 8 kHz mono wav to a raw ADPCM clip")
+    p.add_argument("wav_in")
+    p.add_argument("bin_out")
+    p.set_defaults(func=cmd_wav)
+
+    args = ap.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())